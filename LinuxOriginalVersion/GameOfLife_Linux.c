@@ -1,40 +1,50 @@
-#define _XOPEN_SOURCE   600 /* NEEDED FOR usleep() */
-#define _POSIX_C_SOURCE 200112L /* NEEDED FOR usleep() */
+#define _XOPEN_SOURCE   600 /* NEEDED FOR getopt() & poll() */
+#define _POSIX_C_SOURCE 200112L /* NEEDED FOR getopt() & poll() */
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
 #include <unistd.h>
+#include <poll.h>
+#include <sys/timerfd.h>
+
+#include "GoL_board.h"
+#include "GoL_apiInternal.h"
+#include "GoL_render.h"
+#include "GoL_export.h"
+#include "GoL_input.h"
+#include "GoL_pace.h"
+#include "GoL_ltl.h"
+#include "GoL_noise.h"
+#include "GoL_share.h"
+#include "GoL_census.h"
+#include "GoL_heat.h"
+#include "GoL_search.h"
+#include "../Shared/GoL_patterns.h"
 
 #ifdef _WIN32
 #error "This program only supports Linux!"
 #endif /* _WIN32 */
 
-#define ZERO 0
-#define ONE 1
-#define TWO 2
-#define THREE 3
-#define FOUR 4
-#define FIVE 5
+#define STATUS_LINES 4 /* Generation, Population, Speed & Controls */
 
-#define DEAD 0
-#define LIVE 1
+#define GAMESTATE_FILE "_gamestate_.bin"
 
-#define ROWS 30
-#define COLS 50
-#define ROWS_M_ONE (ROWS - ONE)
-#define COLS_M_ONE (COLS - ONE)
+#define RATE 5 /* Generations per second */
+#define MAX_RATE 100000
+#define PAN_STEP 8 /* Dots */
 
-#define FROM_ASCII_TO_DECIMAL 48
-
-#define TIME_STOP 200000 /* Microseconds */
-
-struct gameStates
-{
-    char gameState1[ROWS][COLS];
-    char gameState2[ROWS][COLS];
+struct observers
+{/* Whatever looks at every finished generation, see afterStep() */
+    Share *live;      /* -p, NULL => off */
+    Census *census;   /* -C, NULL => off */
+    long censusEvery;
+    Search *search;   /* -F, NULL => off */
+    Pyramid *pyramid; /* Tile counts for the search, NULL => counted from the board */
 };
-typedef struct gameStates Gs;
+typedef struct observers Observers;
 
 struct userCXY
 {
@@ -44,44 +54,107 @@ struct userCXY
 };
 typedef struct userCXY UserCXY;
 
-void processGs_FoT(Gs *states);
-void printGs(Gs *states);
-int numOfL(Gs *states);
-void usersDandL(Gs *states, UserCXY *uChoices, int);
-void usersDandL_GUI(Gs *states);
-void prebuiltPatterns(Gs *states, UserCXY *uChoices);
-void deadEdge(Gs *states);
+void usersDandL(GolBoard *board, UserCXY *uChoices, int);
+void usersDandL_GUI(GolBoard *board);
+void prebuiltPatterns(GolBoard *board, UserCXY *uChoices);
 void printChoices(void);
 int getChoice(void);
-int getPosition(UserCXY *uChoices);
+int getPosition(GolBoard *board, UserCXY *uChoices);
+int getOrientation(void);
 void cleanLeftovers(void);
+void printUsage(const char *program);
+void playGs(GolBoard *board, Observers *watch, View *view, long generations, long rate);
+void afterStep(Gs *states, Observers *watch, long gen);
+void reportSearch(Search *search, Gs *states, Pyramid *pyramid, long gen);
+void stopTimer(int timer);
 
-int main(void)
+int main(int argc, char *argv[])
 {
-    Gs states;
+    GolBoard *board;
+    Gs *states;
+    View view;
+    FrameExport frames;
+    Share share;
+    Census census;
+    Pyramid pyramid;
+    Search search;
+    Observers watch = { NULL, NULL, ZERO, NULL, NULL };
+    LtlRule rule;
+    NoiseRule noise;
     UserCXY uChoices;
-    int gen = ZERO;
+    long gen = ZERO, generations = -ONE, rate = RATE; /* gen only counted here while recording */
+    int rows = ROWS, cols = COLS, mode = RENDER_CELLS, option;
+    int viewX = ONE, viewY = ONE, zoom = ONE, threshold = ZERO, format = EXPORT_RAW1, every = ONE, engine = GOL_ENGINE_WORDS, heatKind = -TWO; /* -2 => no -H */
+    const char *exportPath = NULL, *shareName = NULL, *ruleText = NULL, *searchName = NULL;
+
+    while((option = getopt(argc, argv, "r:c:m:x:y:z:t:o:f:n:g:s:e:l:N:p:C:H:F:")) != -ONE)
+    {
+        if(option == 'r') { rows = atoi(optarg) + TWO; /* + dead edge */ }
+        else if(option == 'c') { cols = atoi(optarg) + TWO; }
+        else if(option == 'm') { mode = renderModeFromName(optarg); }
+        else if(option == 'x') { viewX = atoi(optarg); }
+        else if(option == 'y') { viewY = atoi(optarg); }
+        else if(option == 'z') { zoom = atoi(optarg); }
+        else if(option == 't') { threshold = atoi(optarg); }
+        else if(option == 'o') { exportPath = optarg; }
+        else if(option == 'f') { format = exportFormatFromName(optarg); }
+        else if(option == 'n') { every = atoi(optarg); }
+        else if(option == 'g') { generations = atol(optarg); }
+        else if(option == 's') { rate = atol(optarg); }
+        else if(option == 'e') { engine = !strcmp(optarg, "changes") ? GOL_ENGINE_CHANGES : (!strcmp(optarg, "words") ? GOL_ENGINE_WORDS : -ONE); }
+        else if(option == 'p') { shareName = optarg; }
+        else if(option == 'C') { watch.censusEvery = atol(optarg); }
+        else if(option == 'H') { heatKind = heatKindFromName(optarg); }
+        else if(option == 'F') { searchName = optarg; }
+        else if(option == 'l') { engine = parseLtl(&rule, optarg) ? GOL_ENGINE_LTL : -ONE; ruleText = optarg; }
+        else if(option == 'N') { engine = parseNoise(&noise, optarg) ? GOL_ENGINE_NOISE : -ONE; ruleText = optarg; }
+        else { printUsage(argv[ZERO]); return ONE; }
+    }
+    if(rows < FIVE || cols < FIVE || mode < ZERO || zoom < ONE || threshold < ZERO || threshold > 100 || format < ZERO || every < ONE || rate < ZERO || rate > MAX_RATE || engine < ZERO || watch.censusEvery < ZERO
+       || heatKind == -ONE || (format == EXPORT_PGM && heatKind < ZERO))
+    {
+        printUsage(argv[ZERO]);
 
-    memset(states.gameState1, DEAD, sizeof(states.gameState1));
-    memset(states.gameState2, DEAD, sizeof(states.gameState2));
+    return ONE;
+    }
+
+    if((board = golCreate(rows, cols)) == NULL)
+    {
+        printf("%s", "\n*ERROR*\nNot enough memory for the board!\n");
+
+    return ONE;
+    }
+    states = golStates(board); /* Read only here, every change goes through the library */
+    frames.fd = -ONE;
+    if(exportPath != NULL && openExport(&frames, exportPath, format, every, states) == ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nCannot export frames to ", exportPath, "!\n");
+        golDestroy(board);
+
+    return ONE;
+    }
+    initView(&view, mode, STATUS_LINES);
+    panView(&view, states, viewX - ONE, viewY - ONE);
+    while(view.zoom < zoom) { zoomView(&view, ZERO); }
+    view.threshold = threshold;
 
     while(ONE)
     {
         printChoices();
         uChoices.userChoice = getChoice();
-        if(uChoices.userChoice == -TWO) { usersDandL(&states, &uChoices, DEAD); }
-        else if(uChoices.userChoice == -ONE) { usersDandL(&states, &uChoices, LIVE); }
-        else if(uChoices.userChoice == ZERO) { usersDandL_GUI(&states); }
+        if(uChoices.userChoice == -TWO) { usersDandL(board, &uChoices, DEAD); }
+        else if(uChoices.userChoice == -ONE) { usersDandL(board, &uChoices, LIVE); }
+        else if(uChoices.userChoice == ZERO) { usersDandL_GUI(board); }
         else if(uChoices.userChoice == -THREE)
         {
             printf("%s", "\n*RESET COMPLETED*\n\n");
-            memset(states.gameState1, DEAD, sizeof(states.gameState1));
+            golClear(board);
             continue;
         }
-        else if((uChoices.userChoice > ZERO) && (uChoices.userChoice < 8)) /* Vailid choice */
+        else if((uChoices.userChoice > ZERO) && (uChoices.userChoice <= patternCount)) /* Vailid choice */
         {
-            if(getPosition(&uChoices) == ZERO) { continue; /* inVailid choice */ }
-            prebuiltPatterns(&states, &uChoices);
+            if(getPosition(board, &uChoices) == ZERO) { continue; /* inVailid choice */ }
+            prebuiltPatterns(board, &uChoices);
         }
         else
         {
@@ -89,7 +162,7 @@ int main(void)
             continue;
         }
 
-        printGs(&states);
+        printGs(states, &view, "");
 
         printf("\033[0m\033[40m%s", "Start game?\n1 => YES | 0 => NO\n");
         uChoices.userChoice = getChoice();
@@ -98,240 +171,144 @@ int main(void)
         else { continue; }
     }
 
-    deadEdge(&states);
-
-    while(ONE)
-    {
-        printf("\033[0m%s%d%s%d%s", "Generation = ", gen++, "\nPopulation = ", numOfL(&states), "\n");
-        printGs(&states);
-
-        processGs_FoT(&states);
-
-        usleep(TIME_STOP);
-        system("clear");
-    }
-
-return ZERO;
-}
-
-void processGs_FoT(Gs *states)
-{
-    int row, col;
-    /* process Game state */
-    for(row = ONE; row < ROWS_M_ONE; row++)
-    {
-        for(col = ONE; col < COLS_M_ONE; col++)
+    if(golSetEngine(board, engine, ruleText) == ZERO)
+    {/* Built from the finished board */
+        if(engine == GOL_ENGINE_CHANGES) { printf("%s", "\n*ERROR*\nNot enough memory for the change lists, using the word engine!\n"); }
+        else
         {
-            int liveCount;
+            printf("%s", "\n*ERROR*\nNot enough memory for the Larger than Life sums!\n");
+            if(frames.fd >= ZERO) { closeExport(&frames); }
+            freeView(&view);
+            golDestroy(board);
 
-            liveCount = (states -> gameState1[row - ONE][col - ONE]) + (states -> gameState1[row - ONE][col]) + (states -> gameState1[row - ONE][col + ONE]) + (states -> gameState1[row][col - ONE]) + (states -> gameState1[row][col + ONE]) + (states -> gameState1[row + ONE][col - ONE]) + (states -> gameState1[row + ONE][col]) + (states -> gameState1[row + ONE][col + ONE]);
-
-            if( ( (states -> gameState1[row][col]) == LIVE ) && (liveCount == TWO || liveCount == THREE) ) { (states -> gameState2[row][col]) = LIVE; }
-            else if( ( (states -> gameState1[row][col]) == DEAD ) && (liveCount == THREE) ) { (states -> gameState2[row][col]) = LIVE; }
-            else { (states -> gameState2[row][col]) = DEAD; }
+        return ONE;
         }
     }
-    /* Flow of Time */
-    for(row = ONE; row < ROWS_M_ONE; row++) { for(col = ONE; col < COLS_M_ONE; col++) { (states -> gameState1[row][col]) = (states -> gameState2[row][col]); } }
 
-return;
-}
-
-void printGs(Gs *states)
-{
-    int row, col;
-
-    for(row = ONE; row < ROWS_M_ONE; row++)
-    {
-        for(col = ONE; col < COLS_M_ONE; col++)
+    if(heatKind >= ZERO)
+    {/* Counting starts with the first generation played */
+        if(golTrackHeat(board, ONE))
         {
-            if(states -> gameState1[row][col] == DEAD) { printf("\033[30m\033[40m%s", "[]"); /* BLACK LETTERS & BLACK BG */ }
-            else { printf("\033[97m\033[107m%s", "[]"); /* WHITE LETTERS & WHITE BG */ }
+            view.heat = frames.heat = golHeat(board);
+            view.heatKind = frames.heatKind = heatKind;
         }
-        printf("\033[30m\033[40m%s", "\n");
+        else { printf("%s", "\n*ERROR*\nNot enough memory for the heatmap!\n"); }
+    }
+    if(shareName != NULL)
+    {
+        if(openShare(&share, shareName, states)) { watch.live = &share; }
+        else { printf("%s%s%s", "\n*ERROR*\nCannot share the board as ", shareName, ", no live view!\n"); }
     }
+    if(searchName != NULL)
+    {/* name or name,margin */
+        char name[64];
+        const Pattern *pattern;
+        const char *comma = strchr(searchName, ',');
+        int margin = (comma == NULL) ? ONE : atoi(comma + ONE);
+
+        snprintf(name, sizeof(name), "%.*s", (comma == NULL) ? (int) strlen(searchName) : (int) (comma - searchName), searchName);
+        if((pattern = findPattern(name)) != NULL && newSearch(&search, pattern, margin)) { watch.search = &search; }
+        else { printf("%s%s%s", "\n*ERROR*\nCannot search for ", searchName, " (a pattern of the menu, window up to 64x64)!\n"); }
+        if(watch.search != NULL && newPyramid(&pyramid, states)) { watch.pyramid = &pyramid; }
+    }
+    if(watch.censusEvery > ZERO)
+    {
+        if(newCensus(&census, ZERO)) { watch.census = &census; }
+        else { printf("%s", "\n*ERROR*\nNot enough memory for the census!\n"); }
+    }
+    afterStep(states, &watch, ZERO);
 
-return;
-}
+    while((frames.fd >= ZERO) && ((generations < ZERO) || (gen <= generations)))
+    {/* Recording: no terminal output and no waiting */
+        if(exportGs(&frames, states, gen) == ZERO)
+        {
+            printf("%s", "\n*ERROR*\nCannot write frame!\n");
+            break;
+        }
+        if(gen == generations) { break; } /* The board stays at the last frame written */
 
-int numOfL(Gs *states)
-{
-    int row, col, liveCount = ZERO;
+        golStep(board, ONE);
+        gen++;
+        afterStep(states, &watch, gen);
+    }
+    if(frames.fd < ZERO)
+    {/* Zoomed-out frames from block sums, cell by cell if there is no room for them */
+        if(watch.pyramid != NULL) { view.pyramid = watch.pyramid; }
+        else if(newPyramid(&pyramid, states)) { view.pyramid = &pyramid; }
+        playGs(board, &watch, &view, generations, rate);
+    }
 
-    for(row = ONE; row < ROWS_M_ONE; row++) { for(col = ONE; col < COLS_M_ONE; col++) { liveCount += (states -> gameState1[row][col]); } }
+    if(frames.fd >= ZERO) { closeExport(&frames); }
+    if(watch.live != NULL) { closeShare(watch.live); }
+    if(watch.census != NULL) { freeCensus(watch.census); }
+    if(watch.search != NULL) { freeSearch(watch.search); }
+    if(view.pyramid != NULL) { freePyramid(view.pyramid); }
+    else if(watch.pyramid != NULL) { freePyramid(watch.pyramid); }
+    freeView(&view);
+    golDestroy(board);
 
-return liveCount;
+return ZERO;
 }
 
-void usersDandL(Gs *states, UserCXY *uChoices, int LorD)
+void usersDandL(GolBoard *board, UserCXY *uChoices, int LorD)
 {
     printf("%s", "|Give 0 to X for termination|\n");
     while(ONE)
     {
         printf("%s", "\n"); /* Clean Enviro */
-        if((getPosition(uChoices) == ZERO) && (uChoices -> X != ZERO)) { continue; /* inVailid choice for X */ }
+        if((getPosition(board, uChoices) == ZERO) && (uChoices -> X != ZERO)) { continue; /* inVailid choice for X */ }
         if(uChoices -> X == ZERO) { return; }
 
-        if(LorD == LIVE) { states -> gameState1[uChoices -> Y][uChoices -> X] = LIVE; }
-        else if(LorD == DEAD) { states -> gameState1[uChoices -> Y][uChoices -> X] = DEAD; }
+        golSetCell(board, uChoices -> Y, uChoices -> X, LorD);
     }
 }
 
-void usersDandL_GUI(Gs *states)
-{
-    FILE *file;
-    int row, col, DL;
-
-    if((file = fopen("_gamestate_.txt", "wt")) == NULL)
+void usersDandL_GUI(GolBoard *board)
+{/* The board goes both ways as a packed file, see GoL_file.h */
+    if(golSaveFile(board, GAMESTATE_FILE) == ZERO)
     {
         printf("%s", "\n*ERROR*\nCannot load state in GUI input Mode!\n");
 
     return;
     }
 
-    for(row = ONE; row < ROWS_M_ONE; row++)
-    {
-        for(col = ONE; col < COLS_M_ONE; col++) { fprintf(file, "%d", states -> gameState1[row][col]); }
-        fprintf(file, "%s", "\n");
-    }
-    fprintf(file, "%d\n%d", ROWS, COLS);
-
-    fclose(file);
-
     system("python3 GoL-GUI_gamestate_input.py");
 
-    if((file = fopen("_gamestate_.txt", "rt")) == NULL)
+    if(golLoadFile(board, GAMESTATE_FILE) == ZERO)
     {
         printf("%s", "\n*ERROR*\nCannot import state from GUI input Mode!\n");
 
     return;
     }
 
-    row = ONE; col = ONE;
-    while((DL = fgetc(file)) != EOF)
-    {
-        if(row == ROWS_M_ONE) { break; }
-        if(DL == '\n') { continue; }
-
-        states -> gameState1[row][col] = DL - FROM_ASCII_TO_DECIMAL;
-        col++;
-
-        if(col == COLS_M_ONE) { col = ONE; row++; }
-    }
-
-    fclose(file);
-
-return;
-}
-
-void prebuiltPatterns(Gs *states, UserCXY *uChoices)
-{/* MAIN GOAL: NO NEGATIVE number addition IN COORDINATES!!! */
-    int i;
-
-    if(uChoices -> userChoice == ONE) { for(i = ZERO; i < THREE; i++) { states -> gameState1[uChoices -> Y][uChoices -> X + i] = LIVE; } }
-
-    else if(uChoices -> userChoice == TWO)
-    {
-        for(i = ONE; i < FOUR; i++) { states -> gameState1[uChoices -> Y][uChoices -> X + i] = LIVE; }
-        for(i = ZERO; i < THREE; i++) { states -> gameState1[uChoices -> Y + ONE][uChoices -> X + i] = LIVE; }
-    }
-
-    else if(uChoices -> userChoice == THREE)
-    {
-        for(i = ZERO; i < TWO; i++) { states -> gameState1[uChoices -> Y][uChoices -> X + i] = LIVE; }
-        for(i = TWO; i < FOUR; i++) { states -> gameState1[uChoices -> Y + i][uChoices -> X + THREE] = LIVE; }
-        states -> gameState1[uChoices -> Y + THREE][uChoices -> X + TWO] = LIVE;
-        states -> gameState1[uChoices -> Y + ONE][uChoices -> X] = LIVE;
-    }
-
-    else if(uChoices -> userChoice == FOUR)
-    {
-        for(i = ZERO; i < TWO; i++) { states -> gameState1[uChoices -> Y + i][uChoices -> X + ONE + i] = LIVE; }
-        for(i = ZERO; i < THREE; i++) { states -> gameState1[uChoices -> Y + TWO][uChoices -> X + i] = LIVE; }
-    }
-
-    else if(uChoices -> userChoice == FIVE)
-    {
-        for(i = TWO; i < FIVE; i++)
-        {
-            int y = (uChoices -> Y) + i, x = (uChoices -> X) + i, y2 = y + 6, x2 = x + 6;
-
-            states -> gameState1[y][uChoices -> X] = LIVE;
-            states -> gameState1[y][uChoices -> X + FIVE] = LIVE;
-            states -> gameState1[y][uChoices -> X + 7] = LIVE;
-            states -> gameState1[y][uChoices -> X + 12] = LIVE;
-
-            states -> gameState1[uChoices -> Y][x] = LIVE;
-            states -> gameState1[uChoices -> Y + FIVE][x] = LIVE;
-            states -> gameState1[uChoices -> Y + 7][x] = LIVE;
-            states -> gameState1[uChoices -> Y + 12][x] = LIVE;
-
-            states -> gameState1[y2][uChoices -> X] = LIVE;
-            states -> gameState1[y2][uChoices -> X + FIVE] = LIVE;
-            states -> gameState1[y2][uChoices -> X + 7] = LIVE;
-            states -> gameState1[y2][uChoices -> X + 12] = LIVE;
-
-            states -> gameState1[uChoices -> Y][x2] = LIVE;
-            states -> gameState1[uChoices -> Y + FIVE][x2] = LIVE;
-            states -> gameState1[uChoices -> Y + 7][x2] = LIVE;
-            states -> gameState1[uChoices -> Y + 12][x2] = LIVE;
-        }
-    }
-
-    else if(uChoices -> userChoice == 6)
-    {
-        for(i = ZERO; i < THREE; i++) { states -> gameState1[uChoices -> Y + i][uChoices -> X + ONE] = LIVE; }
-        states -> gameState1[uChoices -> Y + ONE][uChoices -> X] = LIVE;
-        states -> gameState1[uChoices -> Y][uChoices -> X + TWO] = LIVE;
-    }
-
-    else if(uChoices -> userChoice == 7)
-    {
-        states -> gameState1[uChoices -> Y][uChoices -> X + ONE] = LIVE;
-        for(i = TWO; i < 6; i++) { states -> gameState1[uChoices -> Y + i][uChoices -> X + ONE] = LIVE; }
-        states -> gameState1[uChoices -> Y + 7][uChoices -> X + ONE] = LIVE;
-        for(i = ZERO; i < 8; i++)
-        {
-            states -> gameState1[uChoices -> Y + i][uChoices -> X] = LIVE;
-            states -> gameState1[uChoices -> Y + i][uChoices -> X + TWO] = LIVE;
-        }
-    }
-
 return;
 }
 
-void deadEdge(Gs *states)
-{
-    int row, col;
+void prebuiltPatterns(GolBoard *board, UserCXY *uChoices)
+{/* Stamped straight from the packed pattern table, anything past the board is clipped */
+    int xy[TWO];
 
-    for(row = ZERO; row < ROWS; row++)
-    {
-        states -> gameState1[row][ZERO] = DEAD;
-        states -> gameState1[row][COLS_M_ONE] = DEAD;
-    }
-    for(col = ZERO; col < COLS; col++)
-    {
-        states -> gameState1[ZERO][col] = DEAD;
-        states -> gameState1[ROWS_M_ONE][col] = DEAD;
-    }
+    xy[ZERO] = uChoices -> X;
+    xy[ONE] = uChoices -> Y;
+    golStampPattern(board, patternTable[uChoices -> userChoice - ONE].name, getOrientation(), xy, ONE);
 
 return;
 }
 
 void printChoices(void)
 {
+    int i;
+
     printf("%s", "-2) Enter dead cells individually\n"
            "-1) Enter live cells individually\n"
            " 0) Enter cells' state in GUI input Mode\n\n"
-           "Patterns to choose from:\n"
-           " 1) Blinker (period 2)\n"
-           " 2) Toad (period 2)\n"
-           " 3) Beacon (period 2)\n"
-           " 4) Glider\n"
-           " 5) Pulsar (period 3)\n"
-           " 6) The R-pentomino\n"
-           " 7) Penta-decathlon (period 15)\n"
-           "\n-2) *RESET*\n\n");
+           "Patterns to choose from:\n");
+    for(i = ZERO; i < patternCount; i++)
+    {
+        if(patternTable[i].info[ZERO] == '\0') { printf("%2d) %s\n", i + ONE, patternTable[i].name); }
+        else { printf("%2d) %s (%s)\n", i + ONE, patternTable[i].name, patternTable[i].info); }
+    }
+    printf("%s", "\n-2) *RESET*\n\n");
 
 return;
 }
@@ -347,23 +324,23 @@ int getChoice(void)
 return userChoice;
 }
 
-int getPosition(UserCXY *uChoices) /* RETURN 1 => OK! */
+int getPosition(GolBoard *board, UserCXY *uChoices) /* RETURN 1 => OK! */
 {
     printf("%s", "X position -> ");
     uChoices -> X = getChoice();
-    if(uChoices -> X < ONE || uChoices -> X > (COLS_M_ONE - ONE))
+    if(uChoices -> X < ONE || uChoices -> X > (golCols(board) - TWO))
     {
         if( (uChoices -> X == ZERO) && ( (uChoices -> userChoice == ZERO) || (uChoices -> userChoice == -ONE) ) ) { return ZERO; }
-        printf("%s%d%s", "\n*INVAILID VALUE!*\n1 < X < ", (COLS_M_ONE - ONE), "\n\n");
+        printf("%s%d%s", "\n*INVAILID VALUE!*\n1 < X < ", (golCols(board) - TWO), "\n\n");
 
     return ZERO;
     }
 
     printf("%s", "Y position -> ");
     uChoices -> Y = getChoice();
-    if(uChoices -> Y < ONE || uChoices -> Y > (ROWS_M_ONE - ONE))
+    if(uChoices -> Y < ONE || uChoices -> Y > (golRows(board) - TWO))
     {
-        printf("%s%d%s", "\n*INVAILID VALUE!*\n1 < Y < ", (ROWS_M_ONE - ONE), "\n\n");
+        printf("%s%d%s", "\n*INVAILID VALUE!*\n1 < Y < ", (golRows(board) - TWO), "\n\n");
 
     return ZERO;
     }
@@ -371,6 +348,156 @@ int getPosition(UserCXY *uChoices) /* RETURN 1 => OK! */
 return ONE;
 }
 
+void stopTimer(int timer)
+{
+    struct itimerspec never;
+
+    memset(&never, ZERO, sizeof(never));
+    timerfd_settime(timer, ZERO, &never, NULL);
+
+return;
+}
+
+void playGs(GolBoard *board, Observers *watch, View *view, long generations, long rate)
+{/* Waits for absolute deadlines: in poll() with a timerfd when keys matter, in clock_nanosleep() otherwise */
+    Gs *states = golStates(board);
+    struct pollfd waitFor[TWO];
+    Pacer pace;
+    long gen = ZERO;
+    int keys[MAX_KEYS], count, i, interactive, paused = ZERO, running = ONE, redraw = ONE, due;
+    int timer = timerfd_create(CLOCK_MONOTONIC, ZERO);
+    char status[512], speed[64];
+
+    if(timer < ZERO)
+    {
+        printf("%s", "\n*ERROR*\nCannot create the generation timer!\n");
+
+    return;
+    }
+    interactive = rawTerminal(ONE);
+    initPacer(&pace, rate);
+
+    while(running)
+    {
+        if(redraw)
+        {
+            if(pace.rate == ZERO) { sprintf(speed, "%s", "as fast as possible"); }
+            else { sprintf(speed, "%ld gen/s", pace.rate); }
+            sprintf(status, "%s%ld%s%ld%s%s%s%s%s%.1f%s%ld%s%ld%s%s%s%s", "Generation = ", gen, "\033[K\nPopulation = ", golPopulation(board),
+                    (paused ? "   *PAUSED*" : ""), "\033[K\n",
+                    "Speed = ", speed, " (achieved ", pace.achieved, " gen/s, ", pace.overruns, " late, ", pace.skipped, " frames skipped)\033[K\n",
+                    "[SPACE] pause  [n] step  [+/-] speed  [f] as fast as possible  [arrows] pan  [z/x] zoom  [q] quit",
+                    (view -> heat == NULL) ? "" : (view -> heatKind == HEAT_AGE) ? "  [h] heat: age" : "  [h] heat: flips", "\033[K\n");
+            printGs(states, view, status);
+            redraw = ZERO;
+        }
+        if((generations >= ZERO) && (gen >= generations)) { break; }
+
+        due = ZERO;
+        if(!interactive)
+        {
+            waitPacer(&pace);
+            due = ONE;
+        }
+        else
+        {
+            int timeout = -ONE; /* Paused => sleep until a key arrives */
+
+            waitFor[ZERO].fd = timer;
+            waitFor[ZERO].events = POLLIN;
+            waitFor[ONE].fd = STDIN_FILENO;
+            waitFor[ONE].events = POLLIN;
+            if(!paused && armPacer(&pace, timer) == ZERO) { timeout = ZERO; /* As fast as possible, only peek at the keys */ }
+            if(poll(waitFor, TWO, timeout) < ZERO)
+            {
+                if(errno == EINTR) { continue; }
+                break;
+            }
+
+            if(waitFor[ZERO].revents & POLLIN)
+            {
+                uint64_t expirations;
+
+                if(read(timer, &expirations, sizeof(expirations)) == sizeof(expirations)) { due = ONE; }
+            }
+            if(pace.rate == ZERO) { due = ONE; }
+
+            if(waitFor[ONE].revents & (POLLIN | POLLHUP))
+            {
+                if((count = readKeys(keys)) < ZERO) { break; }
+                for(i = ZERO; i < count; i++)
+                {
+                    int key = keys[i];
+
+                    if(key == 'q' || key == 'Q' || key == KEY_ESC || key == THREE /* Ctrl-C */) { running = ZERO; }
+                    else if(key == ' ' || key == 'p' || key == 'P')
+                    {
+                        paused = !paused;
+                        if(paused) { stopTimer(timer); }
+                        else { initPacer(&pace, pace.rate); /* The pause is not lateness */ }
+                    }
+                    else if((key == 'n' || key == 'N' || key == '.') && paused)
+                    {
+                        golStep(board, ONE);
+                        gen++;
+                        afterStep(states, watch, gen);
+                    }
+                    else if((key == '+' || key == '=') && pace.rate > ZERO && pace.rate < MAX_RATE) { initPacer(&pace, pace.rate * TWO); }
+                    else if(key == '-' && pace.rate > ONE) { initPacer(&pace, pace.rate / TWO); }
+                    else if(key == '-' && pace.rate == ZERO) { initPacer(&pace, MAX_RATE); }
+                    else if(key == 'f' || key == 'F') { initPacer(&pace, (pace.rate == ZERO) ? RATE : ZERO); }
+                    else if(key == KEY_UP || key == 'w' || key == 'W') { panView(view, states, ZERO, -PAN_STEP * view -> zoom); }
+                    else if(key == KEY_DOWN || key == 's' || key == 'S') { panView(view, states, ZERO, PAN_STEP * view -> zoom); }
+                    else if(key == KEY_LEFT || key == 'a' || key == 'A') { panView(view, states, -PAN_STEP * view -> zoom, ZERO); }
+                    else if(key == KEY_RIGHT || key == 'd' || key == 'D') { panView(view, states, PAN_STEP * view -> zoom, ZERO); }
+                    else if(key == 'z' || key == 'Z') { zoomView(view, ONE); }
+                    else if(key == 'x' || key == 'X') { zoomView(view, ZERO); }
+                    else if(key == 'h' || key == 'H') { view -> heatKind = (view -> heatKind == HEAT_AGE) ? HEAT_FLIPS : HEAT_AGE; }
+                }
+                redraw = ONE;
+            }
+        }
+
+        if(due && !paused)
+        {
+            golStep(board, ONE);
+            gen++;
+            afterStep(states, watch, gen); /* Every generation, drawn or not */
+            if(tickPacer(&pace)) { redraw = ONE; }
+        }
+    }
+
+    rawTerminal(ZERO);
+    close(timer);
+    printf("%s", "\n");
+
+return;
+}
+
+void afterStep(Gs *states, Observers *watch, long gen)
+{
+    if(watch -> live != NULL) { publishGs(watch -> live, states, gen); }
+    if(watch -> census != NULL && (gen % watch -> censusEvery) == ZERO)
+    {/* On stderr, so it can go to a file while the board is drawn */
+        if(takeCensus(watch -> census, states)) { printCensus(watch -> census, stderr, gen); }
+        else { fprintf(stderr, "%s", "\n*ERROR*\nNot enough memory for the census!\n"); }
+    }
+    if(watch -> search != NULL) { reportSearch(watch -> search, states, watch -> pyramid, gen); }
+
+return;
+}
+
+int getOrientation(void)
+{
+    int orientation;
+
+    printf("%s", "Orientation (0 => as is, 1-3 => rotated 90/180/270, 4-7 => mirrored) -> ");
+    orientation = getChoice();
+    if(orientation < ZERO || orientation >= PATTERN_TRANSFORMS) { orientation = PATTERN_IDENTITY; }
+
+return orientation;
+}
+
 void cleanLeftovers(void)
 { /* "KATHARISE" TO input THS scanf() */
     char trow;
@@ -379,3 +506,50 @@ void cleanLeftovers(void)
 
 return;
 }
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [-r rows] [-c cols] [-m cells|half|braille] [-x col] [-y row] [-z zoom] [-t percent]\n"
+           "       [-o file|-] [-f raw1|raw8|pbm|ppm|pgm] [-n every] [-g generations] [-s rate] [-e words|changes] [-l rule] [-N rule] [-p name] [-C every]\n"
+           "       [-H age|flips] [-F pattern[,margin]]\n"
+           "  -r, -c  Board size (default %dx%d)\n"
+           "  -m      cells: [] per cell | half: 1x2 cells per character | braille: 2x4 cells per character\n"
+           "  -x, -y  Board cell at the top left corner of the view\n"
+           "  -z      Cells per dot side when zoomed out (rounded up to a power of 2)\n"
+           "  -t      Zoomed out dots light up at this %% of live cells (0 => any)\n"
+           "  -o      Record frames to a file (- => stdout, menus move to stderr) instead of drawing them\n"
+           "  -f      Frame format: raw1 (monob) | raw8 (gray) | pbm | ppm | pgm (the heatmap, needs -H) (default raw1)\n"
+           "  -n      Record every Nth generation only\n"
+           "  -g      Stop after this many generations\n"
+           "  -s      Generations per second (default %d, 0 => as fast as possible)\n"
+           "  -e      words: whole board, 64 cells at a time (default) | changes: only around last generation's flips\n"
+           "  -l      Larger than Life rule instead of Conway's, e.g. R5,C0,M1,S34..58,B34..45 (Bosco)\n"
+           "  -N      Conway's rule by chance: births, survivals and random flips, e.g. B0.95,S0.99,N0.0001,seed=7\n"
+           "  -p      Publish every generation to shared memory for GoL_viewer (e.g. %s)\n"
+           "  -C      Object census every N generations, written to stderr\n"
+           "  -F      Find a pattern of the menu every generation, any orientation, e.g. Glider or LWSS,2 (margin of dead cells, default 1), on stderr\n"
+           "  -H      Heatmap behind the cells (cells & half modes): age: hot => changed lately | flips: hot => changed often ([h] switches)\n",
+           program, ROWS - TWO, COLS - TWO, RATE, SHARE_NAME);
+
+return;
+}
+
+void reportSearch(Search *search, Gs *states, Pyramid *pyramid, long gen)
+{/* On stderr like the census: how many, and how many each way (a spaceship's orientation is its heading) */
+    static const char *turns[PATTERN_TRANSFORMS] = { "as is", "rot90", "rot180", "rot270", "flip-x", "flip-y", "transpose", "anti-transpose" };
+    long hits = searchGs(search, states, pyramid), each[PATTERN_TRANSFORMS] = { ZERO }, i;
+    int o;
+
+    if(hits < ZERO)
+    {
+        fprintf(stderr, "%s", "\n*ERROR*\nNot enough memory for the search!\n");
+
+    return;
+    }
+    for(i = ZERO; i < hits; i++) { each[search -> hits[i].transform]++; }
+    fprintf(stderr, "Generation = %ld, %s = %ld", gen, search -> name, hits);
+    for(o = ZERO; o < PATTERN_TRANSFORMS; o++) { if(each[o]) { fprintf(stderr, ", %s %ld", turns[o], each[o]); } }
+    fprintf(stderr, "%s", "\n");
+
+return;
+}
@@ -1,94 +1,228 @@
+import struct
 import tkinter as tk
 
-class Button:
-    deadColor = "black"
-    activeDeadColor = "green"
-    
-    liveColor = "white"
-    activeLiveColor = "red"
-    
-    def __init__(self, row, col, frame):
-        self.row = row
-        self.col = col
-        self.frame = frame
-
-        if GUI_Layout.button_state[self.row][self.col] == 0:
-            self.b = tk.Button(self.frame, bg = Button.deadColor, activebackground = Button.activeDeadColor, relief = "flat")
+#Packed gamestate shared with the C program (see saveGs()/loadGs() in GoL_file.c):
+#  "GoLB", rows, cols, rowBytes (little endian uint32), then rows * rowBytes bytes.
+#  Bit (col % 8) of byte (col // 8) of a row is the cell at col. Row/col 0 and the
+#  last row/col are the dead edge, they are never shown or edited.
+GAMESTATE_FILE = '_gamestate_.bin'
+MAGIC = b'GoLB'
+HEADER = struct.Struct('<4sIII')
+
+class Board:
+    def __init__(self, path):
+        with open(path, 'rb') as file:
+            magic, self.rows, self.cols, self.rowBytes = HEADER.unpack(file.read(HEADER.size))
+            if magic != MAGIC:
+                raise ValueError(path + " is not a packed gamestate")
+            self.cells = bytearray(file.read(self.rows * self.rowBytes))
+
+    def save(self, path):
+        with open(path, 'wb') as file:
+            file.write(HEADER.pack(MAGIC, self.rows, self.cols, self.rowBytes) + self.cells)
+
+    def get(self, row, col):
+        return (self.cells[row * self.rowBytes + (col >> 3)] >> (col & 7)) & 1
+
+    def set(self, row, col, live):
+        if row < 1 or row >= self.rows - 1 or col < 1 or col >= self.cols - 1:
+            return False # Dead edge / outside
+        index = row * self.rowBytes + (col >> 3)
+        if live:
+            self.cells[index] |= 1 << (col & 7)
         else:
-            self.b = tk.Button(self.frame, bg = Button.liveColor, activebackground = Button.activeLiveColor, relief = "flat")
-        self.b.bind("<Button-1>", self.react)
-        self.b.grid(row = self.row, column = self.col)
-
-    def react(self, frame):
-        if self.b.cget("bg") == Button.deadColor:
-            self.b.config(bg = Button.liveColor, activebackground = Button.activeLiveColor)
-            GUI_Layout.button_state[self.row][self.col] = 1
+            self.cells[index] &= ~(1 << (col & 7)) & 0xff
+        return True
+
+class BoardView:
+    deadColor = b'\x00\x00\x00'
+    liveColor = b'\xff\xff\xff'
+    deadColorName = "black"
+    liveColorName = "white"
+
+    width = 800
+    height = 600
+    maxScale = 32 # Pixels per cell
+    minScale = -16 # Negative => cells per pixel
+
+    def __init__(self, board, frame):
+        self.board = board
+        self.scale = max(1, min(BoardView.maxScale, BoardView.width // max(1, board.cols - 2), BoardView.height // max(1, board.rows - 2)))
+        self.row0 = 1 # Board cell at the top left corner
+        self.col0 = 1
+        self.lastCell = None
+
+        #8 cells => 24 RGB bytes, so a whole row is built with one lookup per byte
+        self.byteToRGB = [b''.join(BoardView.liveColor if (byte >> bit) & 1 else BoardView.deadColor for bit in range(8)) for byte in range(256)]
+
+        self.canvas = tk.Canvas(frame, width = BoardView.width, height = BoardView.height, bg = BoardView.deadColorName, highlightthickness = 0)
+        self.canvas.pack(fill = 'both', expand = True)
+        self.image = None
+        self.item = self.canvas.create_image(0, 0, anchor = 'nw')
+
+        self.canvas.bind("<Button-1>", lambda event: self.paint(event, 1, True))
+        self.canvas.bind("<B1-Motion>", lambda event: self.paint(event, 1, False))
+        self.canvas.bind("<Button-3>", lambda event: self.paint(event, 0, True))
+        self.canvas.bind("<B3-Motion>", lambda event: self.paint(event, 0, False))
+        self.canvas.bind("<Button-2>", self.startPan)
+        self.canvas.bind("<B2-Motion>", self.pan)
+        self.canvas.bind("<MouseWheel>", lambda event: self.zoom(event, event.delta > 0))
+        self.canvas.bind("<Button-4>", lambda event: self.zoom(event, True))
+        self.canvas.bind("<Button-5>", lambda event: self.zoom(event, False))
+        self.canvas.bind("<Configure>", lambda event: self.redraw())
+        frame.bind_all("<Key>", self.key)
+
+        self.redraw()
+
+    def cellsPerPixel(self):
+        return -self.scale if self.scale < 0 else 1
+
+    def pixelsPerCell(self):
+        return self.scale if self.scale > 0 else 1
+
+    def visible(self):
+        #Cells covered by the canvas, clipped to the board without its dead edge
+        width = max(1, self.canvas.winfo_width()) * self.cellsPerPixel() // self.pixelsPerCell() + 1
+        height = max(1, self.canvas.winfo_height()) * self.cellsPerPixel() // self.pixelsPerCell() + 1
+        return min(self.board.cols - 1 - self.col0, width), min(self.board.rows - 1 - self.row0, height)
+
+    def redraw(self):
+        #Only the visible part is turned into a PPM image, Tk scales it up or down
+        cols, rows = self.visible()
+        if cols <= 0 or rows <= 0:
+            return
+        board, table = self.board, self.byteToRGB
+        first, last = self.col0 >> 3, (self.col0 + cols - 1) >> 3
+        skip = (self.col0 & 7) * 3
+        data = [b'P6 %d %d 255\n' % (cols, rows)]
+        for row in range(self.row0, self.row0 + rows):
+            start = row * board.rowBytes
+            line = b''.join([table[byte] for byte in board.cells[start + first:start + last + 1]])
+            data.append(line[skip:skip + cols * 3])
+        image = tk.PhotoImage(data = b''.join(data), format = 'PPM')
+        if self.scale > 1:
+            image = image.zoom(self.scale)
+        elif self.scale < -1:
+            image = image.subsample(-self.scale)
+        self.image = image # Keep a reference or Tk drops the image
+        self.canvas.itemconfig(self.item, image = self.image)
+
+    def cellAt(self, event):
+        return (self.row0 + event.y * self.cellsPerPixel() // self.pixelsPerCell(),
+                self.col0 + event.x * self.cellsPerPixel() // self.pixelsPerCell())
+
+    def paint(self, event, live, first):
+        cell = self.cellAt(event)
+        #Fill the gap between two motion events, a quick drag skips cells otherwise
+        cells = [cell] if first or self.lastCell is None else line(self.lastCell, cell)
+        self.lastCell = cell
+        changed = False
+        for row, col in cells:
+            if not self.board.set(row, col, live):
+                continue
+            changed = True
+            if self.scale > 0:
+                x, y = (col - self.col0) * self.scale, (row - self.row0) * self.scale
+                self.image.put(BoardView.liveColorName if live else BoardView.deadColorName, to = (x, y, x + self.scale, y + self.scale))
+        if changed and self.scale < 0:
+            self.redraw()
+
+    def startPan(self, event):
+        self.panFrom = (event.x, event.y, self.row0, self.col0)
+
+    def pan(self, event):
+        x, y, row0, col0 = self.panFrom
+        self.moveTo(row0 - (event.y - y) * self.cellsPerPixel() // self.pixelsPerCell(),
+                    col0 - (event.x - x) * self.cellsPerPixel() // self.pixelsPerCell())
+
+    def moveTo(self, row0, col0):
+        row0 = max(1, min(self.board.rows - 2, row0))
+        col0 = max(1, min(self.board.cols - 2, col0))
+        if (row0, col0) != (self.row0, self.col0):
+            self.row0, self.col0 = row0, col0
+            self.redraw()
+
+    def zoom(self, event, zoomIn):
+        #Keep the cell under the mouse where it is
+        row, col = self.cellAt(event)
+        if zoomIn:
+            scale = 1 if self.scale == -2 else (self.scale // 2 if self.scale < 0 else min(BoardView.maxScale, self.scale * 2))
         else:
-            self.b.config(bg = Button.deadColor, activebackground = Button.activeDeadColor)
-            GUI_Layout.button_state[self.row][self.col] = 0
+            scale = -2 if self.scale == 1 else (max(BoardView.minScale, self.scale * 2) if self.scale < 0 else self.scale // 2)
+        if scale == self.scale:
+            return
+        self.scale = scale
+        self.row0 = max(1, min(self.board.rows - 2, row - event.y * self.cellsPerPixel() // self.pixelsPerCell()))
+        self.col0 = max(1, min(self.board.cols - 2, col - event.x * self.cellsPerPixel() // self.pixelsPerCell()))
+        self.redraw()
+
+    def key(self, event):
+        step = max(1, 64 * self.cellsPerPixel() // self.pixelsPerCell())
+        moves = {'Up': (-step, 0), 'Down': (step, 0), 'Left': (0, -step), 'Right': (0, step)}
+        if event.keysym in moves:
+            self.moveTo(self.row0 + moves[event.keysym][0], self.col0 + moves[event.keysym][1])
+        elif event.char in ('+', '='):
+            event.x, event.y = 0, 0
+            self.zoom(event, True)
+        elif event.char == '-':
+            event.x, event.y = 0, 0
+            self.zoom(event, False)
+
+def line(start, end):
+    #Bresenham, start excluded
+    (row0, col0), (row1, col1) = start, end
+    dRow, dCol = abs(row1 - row0), abs(col1 - col0)
+    stepRow, stepCol = (1 if row1 > row0 else -1), (1 if col1 > col0 else -1)
+    error = dCol - dRow
+    cells = []
+    while (row0, col0) != (row1, col1):
+        doubled = 2 * error
+        if doubled > -dRow:
+            error -= dRow
+            col0 += stepCol
+        if doubled < dCol:
+            error += dCol
+            row0 += stepRow
+        cells.append((row0, col0))
+    return cells
 
 class ControlButton:
-    def __init__(self, frame):
+    def __init__(self, frame, board):
         self.frame = frame
+        self.board = board
 
         self.b = tk.Button(self.frame, text = 'Import gamestate', bg = "cyan", activebackground = 'yellow')
         self.b.bind("<Button-1>", self.save_nonGUI_gamestate)
         self.b.pack(fill = 'x')
 
-    def save_nonGUI_gamestate(self, frame):
-        file = open('_gamestate_.txt', 'w', encoding = 'ASCII')
+        tk.Label(self.frame, text = "Left drag: live | Right drag: dead | Middle drag / arrows: pan | Wheel / +,-: zoom").pack(fill = 'x')
 
-        out = ""
-        for row in GUI_Layout.MAX_ROW:
-            for col in GUI_Layout.MAX_COL:
-                out += str(GUI_Layout.button_state[row][col])
-            out += '\n'
-
-        file.write(out)
-        file.close()
+    def save_nonGUI_gamestate(self, frame):
+        self.board.save(GAMESTATE_FILE)
 
         print("\n--GUI input Mode terminated successfully--\n")
         exit(0)
-        
+
 class GUI_Layout:
-    #Load non-GUI gamestate to buttons states.
-    file = open('_gamestate_.txt', 'r', encoding = 'ASCII')
-    out = file.read()
-    file.close()
-
-    out_lst = out.split('\n')
-
-    MAX_COL_num = int(out_lst[-1]) - 2
-    MAX_COL = range(MAX_COL_num)
-    MAX_ROW = range(int(out_lst[-2]) - 2)
-
-    button_state = []
-    col_lst = []
-    for row in MAX_ROW:
-        for col in MAX_COL:
-            col_lst.append(int(out_lst[row][col]))
-        button_state.append(col_lst[-MAX_COL_num:])
-    #Load non-GUI gamestate to buttons states.
-    
-    def __init__(self, root):
+    def __init__(self, root, board):
         self.r = root
-            
-        self.f_buttons = tk.Frame(root)
-        for row in GUI_Layout.MAX_ROW:
-            for col in GUI_Layout.MAX_COL:
-                button = Button(row, col, self.f_buttons)
-        self.f_buttons.pack()
-            
+
+        self.f_board = tk.Frame(root)
+        self.view = BoardView(board, self.f_board)
+        self.f_board.pack(fill = 'both', expand = True)
+
         self.f_control = tk.Frame(root)
-        saveState = ControlButton(self.f_control)
+        saveState = ControlButton(self.f_control, board)
         self.f_control.pack(fill = 'x')
 
 def main():
+    #Load non-GUI gamestate
+    board = Board(GAMESTATE_FILE)
+
     root = tk.Tk()
     root.title("GUI input Mode (Gamestate)")
-    root.resizable(False, False)
 
-    Gamestate = GUI_Layout(root)
+    Gamestate = GUI_Layout(root, board)
 
     root.mainloop()
 
@@ -0,0 +1,334 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_apiInternal.h"
+#include "GoL_changes.h"
+#include "GoL_file.h"
+#include "GoL_ltl.h"
+#include "GoL_noise.h"
+#include "../Shared/GoL_patterns.h"
+
+struct golBoard
+{
+    Gs states;
+    int engine;
+    int touched;     /* Cells changed since the engine last saw the board */
+    long generation;
+    Changes changes; /* GOL_ENGINE_CHANGES */
+    Ltl ltl;         /* GOL_ENGINE_LTL */
+    NoiseRule noise; /* GOL_ENGINE_NOISE, the generation counts keep runs reproducible */
+    int heatOn;
+    HeatMap heat;    /* golTrackHeat() */
+};
+
+static void dropEngine(GolBoard *board)
+{
+    if(board -> engine == GOL_ENGINE_CHANGES) { freeChanges(&board -> changes); }
+    if(board -> engine == GOL_ENGINE_LTL) { freeLtl(&board -> ltl); }
+    board -> engine = GOL_ENGINE_WORDS;
+
+return;
+}
+
+static int inside(const GolBoard *board, int row, int col)
+{/* Cells that may live: inside the dead edge */
+return row > ZERO && col > ZERO && row < board -> states.rows - ONE && col < board -> states.cols - ONE;
+}
+
+GolBoard *golCreate(int rows, int cols) /* NULL => bad size or out of memory */
+{
+    GolBoard *board;
+
+    if(rows < THREE || cols < THREE || (board = calloc(ONE, sizeof(GolBoard))) == NULL) { return NULL; }
+    if(newGs(&board -> states, rows, cols) == ZERO)
+    {
+        free(board);
+
+    return NULL;
+    }
+    board -> engine = GOL_ENGINE_WORDS;
+
+return board;
+}
+
+void golDestroy(GolBoard *board)
+{
+    if(board == NULL) { return; }
+    dropEngine(board);
+    golTrackHeat(board, ZERO);
+    freeGs(&board -> states);
+    free(board);
+
+return;
+}
+
+int golRows(const GolBoard *board)
+{
+return board -> states.rows;
+}
+
+int golCols(const GolBoard *board)
+{
+return board -> states.cols;
+}
+
+int golSetEngine(GolBoard *board, int engine, const char *rule) /* rule only for GOL_ENGINE_LTL & NOISE */
+{
+    LtlRule ltlRule;
+    NoiseRule noiseRule;
+
+    if(engine == GOL_ENGINE_LTL && (rule == NULL || parseLtl(&ltlRule, rule) == ZERO)) { return ZERO; }
+    if(engine == GOL_ENGINE_NOISE && (rule == NULL || parseNoise(&noiseRule, rule) == ZERO)) { return ZERO; }
+    if(engine != GOL_ENGINE_WORDS && engine != GOL_ENGINE_CHANGES && engine != GOL_ENGINE_LTL && engine != GOL_ENGINE_NOISE) { return ZERO; }
+
+    dropEngine(board);
+    deadEdge(&board -> states);
+    board -> touched = ZERO;
+    if(engine == GOL_ENGINE_CHANGES && newChanges(&board -> changes, &board -> states) == ZERO) { return ZERO; }
+    if(engine == GOL_ENGINE_LTL && newLtl(&board -> ltl, &board -> states, &ltlRule) == ZERO) { return ZERO; }
+    if(engine == GOL_ENGINE_NOISE) { board -> noise = noiseRule; }
+    board -> engine = engine;
+
+return ONE;
+}
+
+int golGetCell(const GolBoard *board, int row, int col) /* 0 outside the board */
+{
+    if(!inside(board, row, col)) { return DEAD; }
+
+return GET_CELL(&board -> states, row, col);
+}
+
+void golSetCell(GolBoard *board, int row, int col, int alive) /* The dead edge and outside are ignored */
+{
+    if(!inside(board, row, col)) { return; }
+    if(alive) { SET_CELL(&board -> states, row, col); }
+    else { CLEAR_CELL(&board -> states, row, col); }
+    markCell(&board -> states, row, col);
+    board -> touched = ONE;
+
+return;
+}
+
+void golClear(GolBoard *board)
+{
+    clearGs(&board -> states);
+    board -> touched = ONE;
+
+return;
+}
+
+void golSetRect(GolBoard *board, int row, int col, int height, int width, const unsigned char *cells, size_t stride)
+{
+    int r, c;
+
+    for(r = ZERO; r < height; r++)
+    {
+        for(c = ZERO; c < width; c++) { golSetCell(board, row + r, col + c, cells[((size_t) r * stride) + (size_t) c] != ZERO); }
+    }
+
+return;
+}
+
+void golGetRect(const GolBoard *board, int row, int col, int height, int width, unsigned char *cells, size_t stride)
+{
+    int r, c;
+
+    for(r = ZERO; r < height; r++)
+    {
+        for(c = ZERO; c < width; c++) { cells[((size_t) r * stride) + (size_t) c] = (unsigned char) golGetCell(board, row + r, col + c); }
+    }
+
+return;
+}
+
+int golStampPattern(GolBoard *board, const char *name, int transform, const int *xy, int count)
+{
+    const Pattern *pattern = findPattern(name);
+    Pattern oriented;
+
+    if(pattern == NULL || transform < ZERO || transform >= PATTERN_TRANSFORMS || count < ZERO) { return ZERO; }
+    transformPattern(pattern, transform, &oriented);
+    stampPatternMany(board -> states.gameState1, board -> states.rows, board -> states.cols, board -> states.words, &oriented, xy, count);
+    deadEdge(&board -> states);
+    markAll(&board -> states);
+    board -> touched = ONE;
+
+return ONE;
+}
+
+int golLoadFile(GolBoard *board, const char *path) /* Packed gamestate file, see GoL_file.h */
+{
+    board -> touched = ONE; /* Even a failed load may have cleared it */
+
+return loadGs(&board -> states, path);
+}
+
+int golSaveFile(const GolBoard *board, const char *path)
+{
+return saveGs((Gs *) &board -> states, path);
+}
+
+int golStep(GolBoard *board, long generations)
+{/* All generations in one call, the engine state stays warm between them */
+    long gen;
+
+    if(board -> touched)
+    {/* The edits went straight to the board, the engine catches up once */
+        deadEdge(&board -> states);
+        if(board -> engine == GOL_ENGINE_CHANGES) { syncChanges(&board -> changes, &board -> states); }
+        board -> touched = ZERO;
+    }
+
+    for(gen = ZERO; gen < generations; gen++)
+    {
+        if(board -> heatOn && board -> engine == GOL_ENGINE_WORDS)
+        {/* Counters updated in the same pass as the step */
+            stepHeat(&board -> heat, &board -> states);
+            board -> generation++;
+            continue;
+        }
+        /* The changes engine steps in place: keep the last generation where the others leave it */
+        if(board -> heatOn && board -> engine == GOL_ENGINE_CHANGES) { memcpy(board -> states.gameState2, board -> states.gameState1, gsWords(board -> states.rows, board -> states.cols) * sizeof(uint64_t)); }
+        if(board -> engine == GOL_ENGINE_LTL) { stepLtl(&board -> ltl, &board -> states); }
+        else if(board -> engine == GOL_ENGINE_NOISE) { stepNoise(&board -> noise, &board -> states, board -> generation); }
+        else if(board -> engine == GOL_ENGINE_CHANGES && stepChanges(&board -> changes, &board -> states) == ZERO)
+        {/* Out of memory: the board is still intact, carry on without the change lists */
+            dropEngine(board);
+            processGs_FoT(&board -> states);
+        }
+        else if(board -> engine == GOL_ENGINE_WORDS) { processGs_FoT(&board -> states); }
+        if(board -> heatOn) { updateHeat(&board -> heat, &board -> states); }
+        board -> generation++;
+    }
+
+return ONE;
+}
+
+int golTrackHeat(GolBoard *board, int on)
+{
+    if(board -> heatOn)
+    {
+        freeHeat(&board -> heat);
+        board -> heatOn = ZERO;
+    }
+    if(on) { board -> heatOn = newHeat(&board -> heat, &board -> states); }
+
+return board -> heatOn == (on != ZERO);
+}
+
+const unsigned char *golHeatRow(const GolBoard *board, int kind, int row) /* One byte per column, NULL when not tracked */
+{
+    size_t at = (size_t) row * board -> heat.stride;
+
+    if(!board -> heatOn || row < ZERO || row >= board -> states.rows) { return NULL; }
+    if(kind == GOL_HEAT_AGE) { return board -> heat.age + at; }
+    if(kind == GOL_HEAT_FLIPS) { return board -> heat.flips + at; }
+
+return NULL;
+}
+
+long golPopulation(const GolBoard *board)
+{
+return numOfL((Gs *) &board -> states);
+}
+
+long golCountRect(const GolBoard *board, int row, int col, int height, int width)
+{
+    long liveCount = ZERO;
+    int lastRow = row + height, lastCol = col + width;
+
+    if(row < ZERO) { row = ZERO; }
+    if(col < ZERO) { col = ZERO; }
+    if(lastRow > board -> states.rows) { lastRow = board -> states.rows; }
+    if(lastCol > board -> states.cols) { lastCol = board -> states.cols; }
+    for(; row < lastRow; row++) { liveCount += countRange(GS_ROW(&board -> states, row), col, lastCol); }
+
+return liveCount;
+}
+
+void golGetStats(const GolBoard *board, GolStats *stats)
+{
+    int row, word;
+
+    stats -> generation = board -> generation;
+    stats -> population = ZERO;
+    stats -> top = stats -> left = stats -> bottom = stats -> right = -ONE;
+    for(row = ZERO; row < board -> states.rows; row++)
+    {
+        const uint64_t *cells = GS_ROW(&board -> states, row);
+
+        for(word = ZERO; word < board -> states.words; word++)
+        {
+            int first, last;
+
+            if(cells[word] == ZERO) { continue; }
+            first = (word * WORD_BITS) + __builtin_ctzll(cells[word]);
+            last = (word * WORD_BITS) + 63 - __builtin_clzll(cells[word]);
+            stats -> population += __builtin_popcountll(cells[word]);
+            if(stats -> top < ZERO) { stats -> top = row; }
+            stats -> bottom = row;
+            if(stats -> left < ZERO || first < stats -> left) { stats -> left = first; }
+            if(last > stats -> right) { stats -> right = last; }
+        }
+    }
+
+return;
+}
+
+long golForEachLive(const GolBoard *board, int (*visit)(int row, int col, void *context), void *context)
+{/* Word by word, a live cell at a time off the lowest bit */
+    long visited = ZERO;
+    int row, word;
+
+    for(row = ZERO; row < board -> states.rows; row++)
+    {
+        const uint64_t *cells = GS_ROW(&board -> states, row);
+
+        for(word = ZERO; word < board -> states.words; word++)
+        {
+            uint64_t bits = cells[word];
+
+            while(bits)
+            {
+                visited++;
+                if(visit(row, (word * WORD_BITS) + __builtin_ctzll(bits), context)) { return visited; }
+                bits &= bits - ONE;
+            }
+        }
+    }
+
+return visited;
+}
+
+const uint64_t *golRow(const GolBoard *board, int row)
+{
+    if(row < ZERO || row >= board -> states.rows) { return NULL; }
+
+return GS_ROW(&board -> states, row);
+}
+
+int golWords(const GolBoard *board)
+{
+return board -> states.words;
+}
+
+Gs *golStates(GolBoard *board) /* Same Gs for the board's whole life, call golTouched() after changing cells in it */
+{
+return &board -> states;
+}
+
+void golTouched(GolBoard *board) /* Cells were changed through golStates() */
+{
+    board -> touched = ONE;
+    markAll(&board -> states); /* Which ones is not known */
+
+return;
+}
+
+const HeatMap *golHeat(const GolBoard *board) /* NULL when golTrackHeat() is off */
+{
+    if(!board -> heatOn) { return NULL; }
+
+return &board -> heat;
+}
@@ -0,0 +1,79 @@
+#ifndef GOL_API_H
+#define GOL_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * libgol: the Game of Life without a terminal. A board is an opaque handle, rows x cols
+ * cells with a dead edge (row 0, row rows - 1, column 0 and column cols - 1 never live).
+ * Nothing here reads stdin or writes stdout. Functions returning int: 1 => OK!
+ * GameOfLife_Linux is one client of it; GoL_apiInternal.h gives in-tree tools the board.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct golBoard GolBoard;
+
+enum golEngine
+{
+    GOL_ENGINE_WORDS = 0, /* The whole board 64 cells at a time (default) */
+    GOL_ENGINE_CHANGES,   /* Only around last generation's flips, for big quiet boards */
+    GOL_ENGINE_LTL,       /* Larger than Life, rule in Golly notation e.g. "R5,C0,M1,S34..58,B34..45" */
+    GOL_ENGINE_NOISE      /* Conway's births & survivals by chance plus random flips, e.g. "B0.95,S0.99,N0.0001,seed=7" */
+};
+
+enum golHeat
+{
+    GOL_HEAT_AGE = 0, /* Generations since the cell last changed, 255 => that many or more (or never seen changing) */
+    GOL_HEAT_FLIPS    /* Times the cell changed since tracking started, up to 255 */
+};
+
+struct golStats
+{
+    long generation;   /* Generations stepped since golCreate() */
+    long population;
+    int top;           /* Bounding box of the live cells, -1 everywhere when there are none */
+    int left;
+    int bottom;
+    int right;
+};
+typedef struct golStats GolStats;
+
+GolBoard *golCreate(int rows, int cols); /* NULL => bad size or out of memory */
+void golDestroy(GolBoard *board);
+int golRows(const GolBoard *board);
+int golCols(const GolBoard *board);
+int golSetEngine(GolBoard *board, int engine, const char *rule); /* rule only for GOL_ENGINE_LTL & NOISE, out of memory => GOL_ENGINE_WORDS */
+
+int golGetCell(const GolBoard *board, int row, int col); /* 0 outside the board */
+void golSetCell(GolBoard *board, int row, int col, int alive); /* The dead edge and outside are ignored */
+void golClear(GolBoard *board);
+/* height x width cells at (row, col), one byte each (0 => dead), rows of the array stride bytes apart */
+void golSetRect(GolBoard *board, int row, int col, int height, int width, const unsigned char *cells, size_t stride);
+void golGetRect(const GolBoard *board, int row, int col, int height, int width, unsigned char *cells, size_t stride);
+/* A named pattern of the menu (e.g. "Glider"), 8 orientations (0 => as is), count copies at xy[2i] = col, xy[2i + 1] = row */
+int golStampPattern(GolBoard *board, const char *name, int transform, const int *xy, int count);
+int golLoadFile(GolBoard *board, const char *path); /* Packed gamestate file, see GoL_file.h */
+int golSaveFile(const GolBoard *board, const char *path);
+
+int golStep(GolBoard *board, long generations);
+/* Per cell activity counters kept up by golStep() from now on (reset when turned on again), any engine */
+int golTrackHeat(GolBoard *board, int on);
+const unsigned char *golHeatRow(const GolBoard *board, int kind, int row); /* One byte per column, NULL when not tracked */
+long golPopulation(const GolBoard *board);
+long golCountRect(const GolBoard *board, int row, int col, int height, int width);
+void golGetStats(const GolBoard *board, GolStats *stats);
+/* visit() for every live cell in row order, stops early when it returns non-zero; RETURN cells visited */
+long golForEachLive(const GolBoard *board, int (*visit)(int row, int col, void *context), void *context);
+/* Packed row: bit (col % 64) of word (col / 64) is the cell at col, valid until the next golStep() */
+const uint64_t *golRow(const GolBoard *board, int row);
+int golWords(const GolBoard *board); /* uint64_t words per packed row */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOL_API_H */
@@ -0,0 +1,14 @@
+#ifndef GOL_API_INTERNAL_H
+#define GOL_API_INTERNAL_H
+
+#include "GoL_api.h"
+#include "GoL_board.h"
+#include "GoL_heat.h"
+
+/* For the tools of this tree only (renderer, export, share, census): the board behind the handle */
+
+Gs *golStates(GolBoard *board); /* Same Gs for the board's whole life, call golTouched() after changing cells in it */
+void golTouched(GolBoard *board); /* Cells were changed through golStates() */
+const HeatMap *golHeat(const GolBoard *board); /* NULL when golTrackHeat() is off */
+
+#endif /* GOL_API_INTERNAL_H */
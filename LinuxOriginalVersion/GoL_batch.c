@@ -0,0 +1,210 @@
+#define _POSIX_C_SOURCE 200112L /* NEEDED FOR posix_memalign() */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_batch.h"
+
+static void transpose64(uint64_t *bits)
+{/* bits[i] bit j <-> bits[j] bit i: swap ever smaller off-diagonal blocks */
+    uint64_t mask = 0x00000000ffffffffULL, swap;
+    int width, row;
+
+    for(width = 32; width != ZERO; width >>= ONE, mask ^= mask << width)
+    {
+        for(row = ZERO; row < 64; row = ((row | width) + ONE) & ~width)
+        {
+            swap = ((bits[row] >> width) ^ bits[row | width]) & mask;
+            bits[row] ^= swap << width;
+            bits[row | width] ^= swap;
+        }
+    }
+
+return;
+}
+
+static int anyLane(Lanes lanes)
+{
+    int word;
+
+    for(word = ZERO; word < BATCH_WORDS; word++) { if(lanes[word]) { return ONE; } }
+
+return ZERO;
+}
+
+int newBatch(Batch *batch, int rows, int cols) /* All lanes empty, RETURN 1 => OK! */
+{
+    size_t bytes = (size_t) rows * (size_t) cols * sizeof(Lanes);
+    void *cells = NULL, *next = NULL;
+
+    memset(batch, ZERO, sizeof(Batch));
+    if(rows < THREE || cols < THREE) { return ZERO; }
+    if(posix_memalign(&cells, sizeof(Lanes), bytes) != ZERO || posix_memalign(&next, sizeof(Lanes), bytes) != ZERO)
+    {
+        free(cells);
+
+    return ZERO;
+    }
+    /* The dead edge of next is never written, it stays this zero */
+    memset(cells, ZERO, bytes);
+    memset(next, ZERO, bytes);
+    batch -> rows = rows;
+    batch -> cols = cols;
+    batch -> cells = cells;
+    batch -> next = next;
+
+return ONE;
+}
+
+static void moveLanes(Batch *batch, int firstLane, Gs *boards, int count, int load)
+{/* 64 lanes x 64 columns at a time: gather the lane words of 64 cells, transpose, and they are board words */
+    uint64_t bits[64];
+    int block, lane, row, word, col, words = WORDS_FOR(batch -> cols);
+
+    for(block = firstLane / WORD_BITS; block <= (firstLane + count - ONE) / WORD_BITS; block++)
+    {
+        for(row = ZERO; row < batch -> rows; row++)
+        {
+            for(word = ZERO; word < words; word++)
+            {
+                Lanes *cells = batch -> cells + ((size_t) row * (size_t) batch -> cols) + ((size_t) word * WORD_BITS);
+                int across = batch -> cols - (word * WORD_BITS);
+
+                if(across > WORD_BITS) { across = WORD_BITS; }
+                for(col = ZERO; col < WORD_BITS; col++) { bits[col] = (col < across) ? cells[col][block] : ZERO; }
+                transpose64(bits);
+                for(lane = ZERO; lane < WORD_BITS; lane++)
+                {
+                    int board = (block * WORD_BITS) + lane - firstLane;
+
+                    if(board < ZERO || board >= count) { continue; }
+                    if(load) { bits[lane] = GS_ROW(&boards[board], row)[word]; }
+                    else { GS_ROW(&boards[board], row)[word] = bits[lane]; }
+                }
+                if(!load) { continue; }
+                transpose64(bits);
+                for(col = ZERO; col < across; col++) { cells[col][block] = bits[col]; }
+            }
+        }
+    }
+
+return;
+}
+
+void loadLanes(Batch *batch, int firstLane, Gs *boards, int count) /* count boards of the batch's size, 64 at a time transposed */
+{
+    if(count > ZERO) { moveLanes(batch, firstLane, boards, count, ONE); }
+
+return;
+}
+
+void storeLanes(const Batch *batch, int firstLane, Gs *boards, int count)
+{
+    if(count > ZERO) { moveLanes((Batch *) batch, firstLane, boards, count, ZERO); }
+
+return;
+}
+
+void clearLane(Batch *batch, int lane)
+{
+    size_t cell, cells = (size_t) batch -> rows * (size_t) batch -> cols;
+
+    for(cell = ZERO; cell < cells; cell++) { batch -> cells[cell][lane / WORD_BITS] &= ~(1ULL << (lane % WORD_BITS)); }
+
+return;
+}
+
+void stepBatch(Batch *batch, long generations)
+{
+    size_t cols = (size_t) batch -> cols;
+    Lanes alive, changed, changed2, *swap;
+    long gen;
+    int row, col;
+
+    for(gen = ZERO; gen < generations; gen++)
+    {
+        memset(&alive, ZERO, sizeof(alive));
+        memset(&changed, ZERO, sizeof(changed));
+        memset(&changed2, ZERO, sizeof(changed2));
+        for(row = ONE; row < batch -> rows - ONE; row++)
+        {
+            const Lanes *up = batch -> cells + ((row - ONE) * cols), *mid = up + cols, *down = mid + cols;
+            Lanes *out = batch -> next + (row * cols);
+
+            for(col = ONE; col < batch -> cols - ONE; col++)
+            {/* processRow()'s adders, the neighbours are whole lane words instead of shifted ones */
+                Lanes sumUp, carryUp, sumDown, carryDown, sumMid, carryMid;
+                Lanes ones, carryOnes, twosLow, twosHigh, twos, fours;
+
+                sumUp = up[col - ONE] ^ up[col] ^ up[col + ONE]; carryUp = (up[col - ONE] & up[col]) | (up[col + ONE] & (up[col - ONE] ^ up[col]));
+                sumDown = down[col - ONE] ^ down[col] ^ down[col + ONE]; carryDown = (down[col - ONE] & down[col]) | (down[col + ONE] & (down[col - ONE] ^ down[col]));
+                sumMid = mid[col - ONE] ^ mid[col + ONE]; carryMid = mid[col - ONE] & mid[col + ONE];
+
+                ones = sumUp ^ sumDown ^ sumMid; carryOnes = (sumUp & sumDown) | (sumMid & (sumUp ^ sumDown));
+                twosLow = carryUp ^ carryDown ^ carryMid; twosHigh = (carryUp & carryDown) | (carryMid & (carryUp ^ carryDown));
+                twos = twosLow ^ carryOnes;
+                fours = twosHigh | (twosLow & carryOnes); /* Any count >= 4 */
+
+                /* out[col] still holds the generation before mid[col] */
+                changed2 |= out[col] ^ (~fours & twos & (ones | mid[col]));
+                out[col] = ~fours & twos & (ones | mid[col]);
+                alive |= out[col];
+                changed |= out[col] ^ mid[col];
+            }
+        }
+        /* Flow of Time */
+        swap = batch -> cells;
+        batch -> cells = batch -> next;
+        batch -> next = swap;
+        batch -> generation++;
+    }
+
+    if(generations > ZERO)
+    {
+        memcpy(batch -> alive, &alive, sizeof(alive));
+        memcpy(batch -> changed, &changed, sizeof(changed));
+        memcpy(batch -> changed2, &changed2, sizeof(changed2));
+    }
+
+return;
+}
+
+void lanePopulations(const Batch *batch, long *populations) /* BATCH_LANES of them */
+{/* Bit-sliced counters: every cell is added to all lanes' counts at once, carries rippling up */
+    Lanes planes[BATCH_PLANES], carry, add;
+    size_t cell, cells = (size_t) batch -> rows * (size_t) batch -> cols;
+    int plane, lane;
+
+    memset(planes, ZERO, sizeof(planes));
+    for(cell = ZERO; cell < cells; cell++)
+    {
+        for(add = batch -> cells[cell], plane = ZERO; plane < BATCH_PLANES && anyLane(add); plane++)
+        {
+            carry = planes[plane] & add;
+            planes[plane] ^= add;
+            add = carry;
+        }
+    }
+
+    for(lane = ZERO; lane < BATCH_LANES; lane++)
+    {
+        populations[lane] = ZERO;
+        for(plane = ZERO; plane < BATCH_PLANES; plane++) { populations[lane] |= (long) ((planes[plane][lane / WORD_BITS] >> (lane % WORD_BITS)) & ONE) << plane; }
+    }
+
+return;
+}
+
+int laneBit(const uint64_t *mask, int lane)
+{
+return (int) ((mask[lane / WORD_BITS] >> (lane % WORD_BITS)) & ONE);
+}
+
+void freeBatch(Batch *batch)
+{
+    free(batch -> cells);
+    free(batch -> next);
+    batch -> cells = batch -> next = NULL;
+
+return;
+}
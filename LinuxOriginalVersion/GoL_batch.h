@@ -0,0 +1,49 @@
+#ifndef GOL_BATCH_H
+#define GOL_BATCH_H
+
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Bit-sliced batch: many small boards of one size stepped in lockstep. Bit k of a cell's
+ * lane word is that cell in board (lane) k, so one pass of the full adders of processRow()
+ * over the cells steps every lane at once. 64 lanes, 256 when built with -mavx2 (GCC vector
+ * extensions, no intrinsics). After each generation the alive/changed/changed2 masks say which
+ * lanes died out, stopped changing or settled into period 2, so they can be stored and loaded
+ * with new boards.
+ */
+
+#ifdef __AVX2__
+#define BATCH_LANES 256
+#else
+#define BATCH_LANES 64
+#endif /* __AVX2__ */
+#define BATCH_WORDS (BATCH_LANES / WORD_BITS) /* uint64_t words of a lane mask */
+#define BATCH_PLANES 32 /* Bits of the bit-sliced population counters */
+
+typedef uint64_t Lanes __attribute__((vector_size(BATCH_LANES / 8)));
+
+struct batch
+{
+    int rows;        /* Every lane's board, dead edge included */
+    int cols;
+    Lanes *cells;    /* rows * cols, row major */
+    Lanes *next;
+    uint64_t alive[BATCH_WORDS];   /* Lanes with a live cell after the last generation */
+    uint64_t changed[BATCH_WORDS]; /* Lanes where the last generation changed a cell */
+    uint64_t changed2[BATCH_WORDS]; /* Lanes that differ from two generations back (valid from the 2nd generation after a load) */
+    long generation;
+};
+typedef struct batch Batch;
+
+int newBatch(Batch *batch, int rows, int cols); /* All lanes empty, RETURN 1 => OK! */
+void loadLanes(Batch *batch, int firstLane, Gs *boards, int count); /* count boards of the batch's size, 64 at a time transposed */
+void storeLanes(const Batch *batch, int firstLane, Gs *boards, int count);
+void clearLane(Batch *batch, int lane);
+void stepBatch(Batch *batch, long generations);
+void lanePopulations(const Batch *batch, long *populations); /* BATCH_LANES of them */
+int laneBit(const uint64_t *mask, int lane);
+void freeBatch(Batch *batch);
+
+#endif /* GOL_BATCH_H */
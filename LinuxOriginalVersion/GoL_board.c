@@ -0,0 +1,230 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_board.h"
+
+int newGs(Gs *states, int rows, int cols) /* RETURN 1 => OK! */
+{
+    size_t cells;
+
+    states -> rows = rows;
+    states -> cols = cols;
+    states -> words = WORDS_FOR(cols);
+    cells = (size_t) rows * (size_t) states -> words;
+    states -> dirty = NULL;
+    states -> stamp = ZERO;
+
+    states -> gameState1 = calloc(cells, sizeof(uint64_t));
+    states -> gameState2 = calloc(cells, sizeof(uint64_t));
+    if(states -> gameState1 == NULL || states -> gameState2 == NULL)
+    {
+        freeGs(states);
+
+    return ZERO;
+    }
+
+return ONE;
+}
+
+size_t gsWords(int rows, int cols) /* Words for one board, placeGs() needs twice that */
+{
+return (size_t) rows * (size_t) WORDS_FOR(cols);
+}
+
+void placeGs(Gs *states, int rows, int cols, uint64_t *memory)
+{/* Caller owns the memory (2 * gsWords()), freeGs() must not be used */
+    states -> rows = rows;
+    states -> cols = cols;
+    states -> words = WORDS_FOR(cols);
+    states -> gameState1 = memory;
+    states -> gameState2 = memory + gsWords(rows, cols);
+    states -> dirty = NULL;
+    states -> stamp = ZERO;
+    memset(memory, DEAD, TWO * gsWords(rows, cols) * sizeof(uint64_t));
+
+return;
+}
+
+void freeGs(Gs *states)
+{
+    free(states -> gameState1);
+    free(states -> gameState2);
+    states -> gameState1 = NULL;
+    states -> gameState2 = NULL;
+    untrackGs(states);
+
+return;
+}
+
+void clearGs(Gs *states)
+{
+    memset(states -> gameState1, DEAD, (size_t) states -> rows * (size_t) states -> words * sizeof(uint64_t));
+    markAll(states);
+
+return;
+}
+
+void processRow(const uint64_t *up, const uint64_t *mid, const uint64_t *down, uint64_t *out, int words)
+{
+    int word;
+    /* 64 cells per word: the 8 neighbour words go through bitwise adders */
+    for(word = ZERO; word < words; word++)
+    {
+        uint64_t upW, upE, midW, midE, downW, downE;
+        uint64_t sumUp, carryUp, sumDown, carryDown, sumMid, carryMid;
+        uint64_t ones, carryOnes, twosLow, twosHigh, twos, fours;
+
+        /* West neighbour of column c is column c - 1, i.e. the next lower bit */
+        upW = (up[word] << ONE) | (word > ZERO ? up[word - ONE] >> 63 : ZERO);
+        upE = (up[word] >> ONE) | (word < words - ONE ? up[word + ONE] << 63 : ZERO);
+        midW = (mid[word] << ONE) | (word > ZERO ? mid[word - ONE] >> 63 : ZERO);
+        midE = (mid[word] >> ONE) | (word < words - ONE ? mid[word + ONE] << 63 : ZERO);
+        downW = (down[word] << ONE) | (word > ZERO ? down[word - ONE] >> 63 : ZERO);
+        downE = (down[word] >> ONE) | (word < words - ONE ? down[word + ONE] << 63 : ZERO);
+
+        /* Full adders per row, then add the partial sums: ones + 2 * twos + 4 * fours */
+        sumUp = upW ^ up[word] ^ upE; carryUp = (upW & up[word]) | (upE & (upW ^ up[word]));
+        sumDown = downW ^ down[word] ^ downE; carryDown = (downW & down[word]) | (downE & (downW ^ down[word]));
+        sumMid = midW ^ midE; carryMid = midW & midE;
+
+        ones = sumUp ^ sumDown ^ sumMid; carryOnes = (sumUp & sumDown) | (sumMid & (sumUp ^ sumDown));
+        twosLow = carryUp ^ carryDown ^ carryMid; twosHigh = (carryUp & carryDown) | (carryMid & (carryUp ^ carryDown));
+        twos = twosLow ^ carryOnes;
+        fours = twosHigh | (twosLow & carryOnes); /* Any count >= 4 */
+
+        /* LIVE with 2 or 3 neighbours stays, DEAD with exactly 3 is born */
+        out[word] = ~fours & twos & (ones | mid[word]);
+    }
+
+return;
+}
+
+void processGs_FoT(Gs *states)
+{
+    int row;
+    size_t words = (size_t) states -> words;
+    uint64_t *swap;
+    /* process Game state */
+    for(row = ONE; row < states -> rows - ONE; row++)
+    {
+        processRow(states -> gameState1 + ((row - ONE) * words), states -> gameState1 + (row * words),
+                   states -> gameState1 + ((row + ONE) * words), states -> gameState2 + (row * words), states -> words);
+        markWords(states, row, states -> gameState1 + (row * words), states -> gameState2 + (row * words));
+    }
+    /* Flow of Time */
+    swap = states -> gameState1;
+    states -> gameState1 = states -> gameState2;
+    states -> gameState2 = swap;
+    deadEdge(states);
+
+return;
+}
+
+long numOfL(Gs *states)
+{
+    size_t word, words = (size_t) states -> rows * (size_t) states -> words;
+    long liveCount = ZERO;
+    /* The dead edge and the padding bits are always empty, so whole rows can be counted */
+    for(word = ZERO; word < words; word++) { liveCount += __builtin_popcountll(states -> gameState1[word]); }
+
+return liveCount;
+}
+
+long countRange(const uint64_t *row, int fromCol, int toCol) /* Live cells in [fromCol, toCol) */
+{
+    long liveCount = ZERO;
+    int word, lastWord;
+
+    if(fromCol >= toCol) { return ZERO; }
+    word = fromCol / WORD_BITS;
+    lastWord = (toCol - ONE) / WORD_BITS;
+    for(; word <= lastWord; word++)
+    {
+        uint64_t bits = row[word];
+
+        if(word == fromCol / WORD_BITS) { bits &= ~0ULL << (fromCol % WORD_BITS); }
+        if(word == lastWord && (toCol % WORD_BITS)) { bits &= (1ULL << (toCol % WORD_BITS)) - ONE; }
+        liveCount += __builtin_popcountll(bits);
+    }
+
+return liveCount;
+}
+
+void deadEdge(Gs *states)
+{
+    int row;
+
+    for(row = ZERO; row < states -> rows; row++)
+    {
+        CLEAR_CELL(states, row, ZERO);
+        CLEAR_CELL(states, row, states -> cols - ONE);
+        /* Padding bits past the last column stay dead too */
+        if(states -> cols % WORD_BITS) { GS_ROW(states, row)[states -> words - ONE] &= (1ULL << (states -> cols % WORD_BITS)) - ONE; }
+    }
+    memset(GS_ROW(states, ZERO), DEAD, (size_t) states -> words * sizeof(uint64_t));
+    memset(GS_ROW(states, states -> rows - ONE), DEAD, (size_t) states -> words * sizeof(uint64_t));
+
+return;
+}
+
+static size_t dirtyWords(const Gs *states)
+{
+return WORDS_FOR(((size_t) (states -> rows + BAND_ROWS - ONE) / BAND_ROWS) * (size_t) states -> words);
+}
+
+int trackGs(Gs *states) /* Every bit set, RETURN 1 => OK! */
+{
+    if(states -> dirty == NULL && (states -> dirty = malloc(dirtyWords(states) * sizeof(uint64_t))) == NULL) { return ZERO; }
+    markAll(states);
+
+return ONE;
+}
+
+void untrackGs(Gs *states) /* freeGs() does it, placeGs() boards need it */
+{
+    free(states -> dirty);
+    states -> dirty = NULL;
+
+return;
+}
+
+void markWords(Gs *states, int row, const uint64_t *before, const uint64_t *after) /* A row, old and new */
+{
+    size_t bit = (size_t) (row / BAND_ROWS) * (size_t) states -> words;
+    uint64_t *dirty = states -> dirty, marks = ZERO;
+    int word, words = states -> words;
+
+    if(dirty == NULL) { return; }
+    for(word = ZERO; word < words; word++, bit++)
+    {/* Gathered in a register, stored once per dirty word */
+        marks |= (uint64_t) (before[word] != after[word]) << (bit % WORD_BITS);
+        if(bit % WORD_BITS == WORD_BITS - ONE || word == words - ONE)
+        {
+            dirty[bit / WORD_BITS] |= marks;
+            marks = ZERO;
+        }
+    }
+    states -> stamp++;
+
+return;
+}
+
+void markCell(Gs *states, int row, int col)
+{
+    size_t bit = ((size_t) (row / BAND_ROWS) * (size_t) states -> words) + (size_t) (col / WORD_BITS);
+
+    if(states -> dirty == NULL) { return; }
+    states -> dirty[bit / WORD_BITS] |= 1ULL << (bit % WORD_BITS);
+    states -> stamp++;
+
+return;
+}
+
+void markAll(Gs *states)
+{
+    if(states -> dirty == NULL) { return; }
+    memset(states -> dirty, 0xff, dirtyWords(states) * sizeof(uint64_t));
+    states -> stamp++;
+
+return;
+}
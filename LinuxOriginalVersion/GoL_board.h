@@ -0,0 +1,58 @@
+#ifndef GOL_BOARD_H
+#define GOL_BOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ZERO 0
+#define ONE 1
+#define TWO 2
+#define THREE 3
+#define FOUR 4
+#define FIVE 5
+
+#define DEAD 0
+#define LIVE 1
+
+#define ROWS 30 /* Default board size, see -r / -c */
+#define COLS 50
+
+#define WORD_BITS 64
+#define WORDS_FOR(cols) (((cols) + WORD_BITS - ONE) / WORD_BITS) /* uint64_t words per packed row */
+#define BAND_ROWS 8 /* Rows per dirty bit: one word of a band of 8 rows is 8 pyramid blocks */
+
+struct gameStates
+{ /* Packed rows: cell (row, col) is bit (col % WORD_BITS) of word (col / WORD_BITS) */
+    int rows;
+    int cols;
+    int words;
+    uint64_t *gameState1;
+    uint64_t *gameState2;
+    uint64_t *dirty;     /* NULL => not tracked, else bit (band * words + word) set when that word of a band changed */
+    unsigned long stamp; /* Bumped by every mark, whoever clears dirty bits keeps the stamp it saw */
+};
+typedef struct gameStates Gs;
+
+#define GS_ROW(states, row) ((states) -> gameState1 + ((size_t) (row) * (size_t) (states) -> words))
+#define GET_CELL(states, row, col) ((int) ((GS_ROW(states, row)[(col) / WORD_BITS] >> ((col) % WORD_BITS)) & ONE))
+#define SET_CELL(states, row, col) (GS_ROW(states, row)[(col) / WORD_BITS] |= (1ULL << ((col) % WORD_BITS)))
+#define CLEAR_CELL(states, row, col) (GS_ROW(states, row)[(col) / WORD_BITS] &= ~(1ULL << ((col) % WORD_BITS)))
+
+int newGs(Gs *states, int rows, int cols); /* RETURN 1 => OK! */
+size_t gsWords(int rows, int cols); /* Words for one board, placeGs() needs twice that */
+void placeGs(Gs *states, int rows, int cols, uint64_t *memory);
+void freeGs(Gs *states);
+void clearGs(Gs *states);
+void processGs_FoT(Gs *states);
+void processRow(const uint64_t *up, const uint64_t *mid, const uint64_t *down, uint64_t *out, int words);
+long numOfL(Gs *states);
+long countRange(const uint64_t *row, int fromCol, int toCol);
+void deadEdge(Gs *states);
+/* Change tracking for syncPyramid(): the steps and edits mark what they change, a no-op on untracked boards */
+int trackGs(Gs *states); /* Every bit set, RETURN 1 => OK! */
+void untrackGs(Gs *states); /* freeGs() does it, placeGs() boards need it */
+void markWords(Gs *states, int row, const uint64_t *before, const uint64_t *after); /* A row, old and new */
+void markCell(Gs *states, int row, int col);
+void markAll(Gs *states);
+
+#endif /* GOL_BOARD_H */
@@ -0,0 +1,157 @@
+#define _XOPEN_SOURCE   600 /* NEEDED FOR getopt() */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "GoL_board.h"
+#include "GoL_file.h"
+#include "GoL_fork.h"
+
+/* What-if runs: one board forked into branches under other rules or with one cell flipped (see GoL_fork.h) */
+
+#define MAX_BRANCHES 256
+
+void printUsage(const char *program);
+
+int main(int argc, char *argv[])
+{
+    Gs states;
+    Branch branches[MAX_BRANCHES];
+    BranchRule rule;
+    const char *path = NULL, *names[MAX_BRANCHES];
+    long gen, generations = 100, population;
+    int rows = ZERO, cols = ZERO, percent = 30, edits = ZERO, count = ZERO, failed = ZERO, option, i, row, col, flipRow[MAX_BRANCHES], flipCol[MAX_BRANCHES];
+    unsigned seed = ONE;
+
+    while((option = getopt(argc, argv, "r:c:d:S:f:g:e:")) != -ONE)
+    {
+        if(option == 'r') { rows = atoi(optarg) + TWO; /* + dead edge */ }
+        else if(option == 'c') { cols = atoi(optarg) + TWO; }
+        else if(option == 'd') { percent = atoi(optarg); }
+        else if(option == 'S') { seed = (unsigned) atol(optarg); }
+        else if(option == 'f') { path = optarg; }
+        else if(option == 'g') { generations = atol(optarg); }
+        else if(option == 'e') { edits = atoi(optarg); }
+        else { printUsage(argv[ZERO]); return ONE; }
+    }
+    if((path == NULL) == (rows == ZERO) || (rows && (rows < THREE || cols < THREE)) || generations < ZERO || edits < ZERO
+       || percent < ZERO || percent > 100 || (argc - optind) + edits + ONE > MAX_BRANCHES)
+    {
+        printUsage(argv[ZERO]);
+
+    return ONE;
+    }
+
+    if(path != NULL)
+    {
+        FILE *file = fopen(path, "rb");
+        unsigned char header[GAMESTATE_HEADER];
+
+        /* The size comes from the file, loadGs() wants a board to load into */
+        if(file == NULL || fread(header, ONE, GAMESTATE_HEADER, file) != GAMESTATE_HEADER || memcmp(header, GAMESTATE_MAGIC, FOUR) != ZERO)
+        {
+            printf("%s%s%s", "\n*ERROR*\nCannot read ", path, " (a packed gamestate, see GoL_file.h)!\n");
+            if(file != NULL) { fclose(file); }
+
+        return ONE;
+        }
+        fclose(file);
+        rows = (int) (header[4] | (header[5] << 8) | (header[6] << 16) | ((unsigned) header[7] << 24));
+        cols = (int) (header[8] | (header[9] << 8) | (header[10] << 16) | ((unsigned) header[11] << 24));
+    }
+    if(newGs(&states, rows, cols) == ZERO)
+    {
+        printf("%s", "\n*ERROR*\nNot enough memory for the board!\n");
+
+    return ONE;
+    }
+    srand(seed);
+    if(path != NULL && loadGs(&states, path) == ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nCannot load ", path, "!\n");
+        freeGs(&states);
+
+    return ONE;
+    }
+    if(path == NULL)
+    {/* Random soup inside the dead edge */
+        for(row = ONE; row < rows - ONE; row++)
+        {
+            for(col = ONE; col < cols - ONE; col++) { if(rand() % 100 < percent) { SET_CELL(&states, row, col); } }
+        }
+    }
+
+    /* Branch 0 runs the first rule (Conway if none), one more per other rule, then the edits of branch 0 */
+    names[ZERO] = (optind < argc) ? argv[optind++] : "B3/S23";
+    if(parseBranchRule(&rule, names[ZERO]) == ZERO || newBranch(&branches[ZERO], &states, &rule) == ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nBad rule or no memory for ", names[ZERO], "!\n");
+        freeGs(&states);
+
+    return ONE;
+    }
+    flipRow[ZERO] = flipCol[ZERO] = ZERO;
+    for(count = ONE; !failed && (optind < argc || edits > ZERO); count++)
+    {
+        if(forkBranch(&branches[count], &branches[ZERO]) == ZERO) { failed = ONE; break; }
+        flipRow[count] = flipCol[count] = ZERO;
+        if(optind < argc)
+        {
+            names[count] = argv[optind++];
+            failed = (parseBranchRule(&branches[count].rule, names[count]) == ZERO);
+        }
+        else
+        {/* Same rule, one cell flipped like usersDandL() would */
+            names[count] = names[ZERO];
+            flipRow[count] = ONE + (rand() % (rows - TWO));
+            flipCol[count] = ONE + (rand() % (cols - TWO));
+            edits--;
+            failed = (setBranchCell(&branches[count], flipRow[count], flipCol[count], !getBranchCell(&branches[count], flipRow[count], flipCol[count])) == ZERO);
+        }
+    }
+    if(failed)
+    {
+        printf("%s", "\n*ERROR*\nBad rule (B3/S23 style, no B0) or not enough memory for every branch!\n");
+        for(i = ZERO; i < count; i++) { freeBranch(&branches[i]); }
+        freeGs(&states);
+
+    return ONE;
+    }
+    printf("%d branches sharing %ld tiles (a full copy each: %ld)\n", count, tilesInUse(), (long) count * branches[ZERO].tilesHigh * branches[ZERO].tilesWide);
+
+    for(gen = ONE; gen <= generations; gen++)
+    {
+        for(i = ZERO; i < count; i++)
+        {
+            if(stepBranch(&branches[i]) == ZERO) { printf("%s", "\n*ERROR*\nNot enough memory to step!\n"); generations = ZERO; break; }
+        }
+    }
+
+    for(i = ZERO; i < count; i++)
+    {
+        population = branchPopulation(&branches[i]);
+        if(flipRow[i]) { printf("Branch %3d: %-12s flipped (%5d, %5d)  Generation = %ld, Population = %ld\n", i, names[i], flipCol[i], flipRow[i], branches[i].generation, population); }
+        else { printf("Branch %3d: %-12s                          Generation = %ld, Population = %ld\n", i, names[i], branches[i].generation, population); }
+    }
+    printf("Tiles in use: %ld (a full copy each: %ld)\n", tilesInUse(), (long) count * branches[ZERO].tilesHigh * branches[ZERO].tilesWide);
+    for(i = ZERO; i < count; i++) { freeBranch(&branches[i]); }
+    freeGs(&states);
+
+return ZERO;
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s (-f board.bin | -r rows -c cols [-d percent] [-S seed]) [-g generations] [-e edits] [rule...]\n"
+           "  -f      Start from a packed gamestate file (e.g. _gamestate_.bin)\n"
+           "  -r, -c  Or from a random soup of -d %% live cells (default 30, -S picks the soup)\n"
+           "  -g      Generations to step every branch (default 100)\n"
+           "  -e      Extra branches of the first rule with one random cell flipped\n"
+           "  rule    B3/S23 style, one branch each (default B3/S23)\n",
+           program);
+
+return;
+}
@@ -0,0 +1,615 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "GoL_census.h"
+#include "../Shared/GoL_patterns.h"
+
+#define MIN_STRIP 32 /* Rows per thread at least, strips must be taller than CENSUS_GAP */
+#define KNOWN_PAD 40 /* Room for the known spaceships to fly while their period is found */
+
+/* Still lifes too common to leave unnamed, the rest of the known objects comes from the pattern table */
+static const Pattern stillLifes[] =
+{
+    { "Block", "", 2, 2,
+      { 0x3,   /* XX */
+        0x3 }  /* XX */ },
+
+    { "Beehive", "", 3, 4,
+      { 0x6,   /* .XX. */
+        0x9,   /* X..X */
+        0x6 }  /* .XX. */ },
+
+    { "Loaf", "", 4, 4,
+      { 0x6,   /* .XX. */
+        0x9,   /* X..X */
+        0xa,   /* .X.X */
+        0x4 }  /* ..X. */ },
+
+    { "Tub", "", 3, 3,
+      { 0x2,   /* .X. */
+        0x5,   /* X.X */
+        0x2 }  /* .X. */ },
+
+    { "Ship", "", 3, 3,
+      { 0x3,   /* XX. */
+        0x5,   /* X.X */
+        0x6 }  /* .XX */ },
+
+    { "Pond", "", 4, 4,
+      { 0x6,   /* .XX. */
+        0x9,   /* X..X */
+        0x9,   /* X..X */
+        0x6 }  /* .XX. */ }
+};
+
+struct labelling
+{/* One census, shared by the threads: live cell ids run row by row over the board */
+    Gs *states;
+    uint32_t *rowFirst;  /* Id of the first live cell of each row */
+    uint32_t *wordFirst; /* Id of the first live cell of each word */
+    uint32_t *parent;    /* Union-find, then component number at the roots */
+    uint32_t *label;     /* Root of each id */
+    uint32_t *top;       /* Per component: bounding box & first id (the root) */
+    uint32_t *left;
+    uint32_t *bottom;
+    uint32_t *right;
+    uint32_t *roots;
+    uint32_t *sizes;     /* Per component: live cells */
+    uint64_t *keys;      /* Per component: canonical form, 0 => too big */
+    uint32_t components;
+};
+
+struct censusJob
+{
+    struct labelling *all;
+    int firstRow;        /* Strip [firstRow, lastRow) */
+    int lastRow;
+    uint32_t firstComponent;
+    uint32_t lastComponent;
+};
+
+static uint64_t rowBits(const uint64_t *row, int words, int from, int to) /* Cells [from, to) to bits 0.., to - from <= 64 */
+{
+    int word = from / WORD_BITS, shift = from % WORD_BITS;
+    uint64_t bits = row[word] >> shift;
+
+    if(shift && word + ONE < words) { bits |= row[word + ONE] << (WORD_BITS - shift); }
+    if(to - from < WORD_BITS) { bits &= (1ULL << (to - from)) - ONE; }
+
+return bits;
+}
+
+static uint32_t idOf(struct labelling *all, int row, int col)
+{
+    uint64_t below = GS_ROW(all -> states, row)[col / WORD_BITS] & ((1ULL << (col % WORD_BITS)) - ONE);
+
+return all -> wordFirst[((size_t) row * (size_t) all -> states -> words) + (size_t) (col / WORD_BITS)] + (uint32_t) __builtin_popcountll(below);
+}
+
+static uint32_t findRoot(uint32_t *parent, uint32_t id)
+{
+    while(parent[id] != id)
+    {
+        parent[id] = parent[parent[id]]; /* Path halving */
+        id = parent[id];
+    }
+
+return id;
+}
+
+static void join(uint32_t *parent, uint32_t a, uint32_t b)
+{/* The smaller id becomes the root, so a root is always the first cell of its object */
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if(a < b) { parent[b] = a; }
+    else if(b < a) { parent[a] = b; }
+
+return;
+}
+
+static void joinAbove(struct labelling *all, int row, int col, uint32_t id, int fromRow)
+{/* Earlier neighbours within CENSUS_GAP: left in this row, then the rows above down to fromRow */
+    Gs *states = all -> states;
+    int above, from = (col - CENSUS_GAP < ZERO) ? ZERO : col - CENSUS_GAP;
+    int to = (col + CENSUS_GAP + ONE > states -> cols) ? states -> cols : col + CENSUS_GAP + ONE;
+    uint64_t near;
+
+    near = rowBits(GS_ROW(states, row), states -> words, from, col);
+    while(near)
+    {
+        join(all -> parent, id, idOf(all, row, from + __builtin_ctzll(near)));
+        near &= near - ONE;
+    }
+    for(above = row - ONE; above >= fromRow && above >= row - CENSUS_GAP; above--)
+    {
+        near = rowBits(GS_ROW(states, above), states -> words, from, to);
+        while(near)
+        {
+            join(all -> parent, id, idOf(all, above, from + __builtin_ctzll(near)));
+            near &= near - ONE;
+        }
+    }
+
+return;
+}
+
+static void *countRows(void *job)
+{
+    struct censusJob *strip = job;
+    Gs *states = strip -> all -> states;
+    int row, word;
+
+    for(row = strip -> firstRow; row < strip -> lastRow; row++)
+    {
+        uint32_t live = ZERO;
+
+        for(word = ZERO; word < states -> words; word++) { live += (uint32_t) __builtin_popcountll(GS_ROW(states, row)[word]); }
+        strip -> all -> rowFirst[row] = live;
+    }
+
+return NULL;
+}
+
+static void *labelStrip(void *job)
+{/* Ids of a strip are its own, so strips are joined without locks; the seams come after */
+    struct censusJob *strip = job;
+    struct labelling *all = strip -> all;
+    Gs *states = all -> states;
+    int row, word;
+
+    for(row = strip -> firstRow; row < strip -> lastRow; row++)
+    {
+        uint32_t id = all -> rowFirst[row];
+
+        for(word = ZERO; word < states -> words; word++)
+        {
+            all -> wordFirst[((size_t) row * (size_t) states -> words) + (size_t) word] = id;
+            id += (uint32_t) __builtin_popcountll(GS_ROW(states, row)[word]);
+        }
+        for(word = ZERO; word < states -> words; word++)
+        {
+            uint64_t live = GS_ROW(states, row)[word];
+
+            while(live)
+            {
+                int col = (word * WORD_BITS) + __builtin_ctzll(live);
+                uint32_t cell = idOf(all, row, col);
+
+                all -> parent[cell] = cell;
+                joinAbove(all, row, col, cell, strip -> firstRow);
+                live &= live - ONE;
+            }
+        }
+    }
+
+return NULL;
+}
+
+static void *findLabels(void *job)
+{/* Read only: no union is running any more */
+    struct censusJob *strip = job;
+    struct labelling *all = strip -> all;
+    uint32_t id, first = all -> rowFirst[strip -> firstRow];
+    uint32_t last = (strip -> lastRow < all -> states -> rows) ? all -> rowFirst[strip -> lastRow] : all -> rowFirst[all -> states -> rows];
+
+    for(id = first; id < last; id++)
+    {
+        uint32_t root = id;
+
+        while(all -> parent[root] != root) { root = all -> parent[root]; }
+        all -> label[id] = root;
+    }
+
+return NULL;
+}
+
+static uint64_t canonicalKey(const Pattern *pattern)
+{/* FNV-1a of the cells, smallest over the 8 orientations */
+    Pattern oriented;
+    uint64_t key = ZERO, hash;
+    int transform, row, byte;
+
+    for(transform = PATTERN_IDENTITY; transform < PATTERN_TRANSFORMS; transform++)
+    {
+        transformPattern(pattern, transform, &oriented);
+        hash = 14695981039346656037ULL;
+        hash = (hash ^ (uint64_t) oriented.rows) * 1099511628211ULL;
+        hash = (hash ^ (uint64_t) oriented.cols) * 1099511628211ULL;
+        for(row = ZERO; row < oriented.rows; row++)
+        {
+            for(byte = ZERO; byte < 8; byte++) { hash = (hash ^ ((oriented.bits[row] >> (byte * 8)) & 0xff)) * 1099511628211ULL; }
+        }
+        if(transform == PATTERN_IDENTITY || hash < key) { key = hash; }
+    }
+
+return key ? key : ONE; /* 0 marks empty slots */
+}
+
+static void *nameComponents(void *job)
+{
+    struct censusJob *range = job;
+    struct labelling *all = range -> all;
+    Gs *states = all -> states;
+    uint32_t component;
+    Pattern cells;
+    int row;
+
+    cells.name = NULL;
+    cells.info = "";
+    for(component = range -> firstComponent; component < range -> lastComponent; component++)
+    {
+        uint32_t root = all -> roots[component];
+
+        cells.rows = (int) (all -> bottom[component] - all -> top[component]) + ONE;
+        cells.cols = (int) (all -> right[component] - all -> left[component]) + ONE;
+        all -> keys[component] = ZERO;
+        if(cells.rows > PATTERN_MAX_SIDE || cells.cols > PATTERN_MAX_SIDE) { continue; }
+
+        for(row = ZERO; row < cells.rows; row++)
+        {/* Only this object's cells: another one may poke into the bounding box */
+            int boardRow = (int) all -> top[component] + row, from = (int) all -> left[component];
+            uint64_t live = rowBits(GS_ROW(states, boardRow), states -> words, from, from + cells.cols), mine = ZERO;
+
+            while(live)
+            {
+                int col = __builtin_ctzll(live);
+
+                if(all -> label[idOf(all, boardRow, from + col)] == root) { mine |= 1ULL << col; }
+                live &= live - ONE;
+            }
+            cells.bits[row] = mine;
+        }
+        all -> keys[component] = canonicalKey(&cells);
+    }
+
+return NULL;
+}
+
+static void runJobs(struct censusJob *jobs, int count, void *(*work)(void *))
+{
+    pthread_t threads[256];
+    int i, started;
+
+    for(started = ONE; started < count && pthread_create(&threads[started], NULL, work, &jobs[started]) == ZERO; started++) { /* Start */ }
+    work(&jobs[ZERO]);
+    for(i = started; i < count; i++) { work(&jobs[i]); /* Thread did not start, do it here */ }
+    for(i = ONE; i < started; i++) { pthread_join(threads[i], NULL); }
+
+return;
+}
+
+static CensusKind *slotFor(CensusKind *table, int size, uint64_t key)
+{
+    int slot = (int) (key & (uint64_t) (size - ONE));
+
+    while(table[slot].key != ZERO && table[slot].key != key) { slot = (slot + ONE) & (size - ONE); }
+
+return &table[slot];
+}
+
+static int growKinds(Census *census) /* RETURN 1 => OK! */
+{
+    CensusKind *old = census -> kinds, *table;
+    int size = census -> kindsSize ? census -> kindsSize * TWO : 256, i;
+
+    if((table = calloc((size_t) size, sizeof(CensusKind))) == NULL) { return ZERO; }
+    for(i = ZERO; i < census -> kindsSize; i++)
+    {
+        if(old[i].key != ZERO) { *slotFor(table, size, old[i].key) = old[i]; }
+    }
+    free(old);
+    census -> kinds = table;
+    census -> kindsSize = size;
+
+return ONE;
+}
+
+static void addKnown(Census *census, const Pattern *pattern)
+{/* Runs the pattern alone until a phase repeats exactly, every phase then names it */
+    Gs board;
+    Pattern phases[CENSUS_MAX_PERIOD + ONE];
+    int tops[CENSUS_MAX_PERIOD + ONE], lefts[CENSUS_MAX_PERIOD + ONE];
+    int side = PATTERN_MAX_SIDE + (TWO * KNOWN_PAD), gen, period = ZERO, row, col;
+
+    if(newGs(&board, side, side) == ZERO) { return; }
+    stampPattern(board.gameState1, board.rows, board.cols, board.words, pattern, KNOWN_PAD, KNOWN_PAD);
+    for(gen = ZERO; gen <= CENSUS_MAX_PERIOD && period == ZERO; gen++)
+    {
+        int top = board.rows, bottom = -ONE, left = board.cols, right = -ONE;
+
+        for(row = ZERO; row < board.rows; row++)
+        {
+            for(col = ZERO; col < board.cols; col++)
+            {
+                if(!GET_CELL(&board, row, col)) { continue; }
+                if(row < top) { top = row; }
+                if(row > bottom) { bottom = row; }
+                if(col < left) { left = col; }
+                if(col > right) { right = col; }
+            }
+        }
+        if(bottom < ZERO || bottom - top >= PATTERN_MAX_SIDE || right - left >= PATTERN_MAX_SIDE || top == ZERO || left == ZERO) { break; /* Died, grew or hit the edge */ }
+
+        memset(&phases[gen], ZERO, sizeof(Pattern));
+        phases[gen].name = pattern -> name;
+        phases[gen].rows = bottom - top + ONE;
+        phases[gen].cols = right - left + ONE;
+        for(row = ZERO; row < phases[gen].rows; row++) { phases[gen].bits[row] = rowBits(GS_ROW(&board, top + row), board.words, left, right + ONE); }
+        tops[gen] = top;
+        lefts[gen] = left;
+        if(gen > ZERO && phases[gen].rows == phases[ZERO].rows && phases[gen].cols == phases[ZERO].cols
+           && memcmp(phases[gen].bits, phases[ZERO].bits, (size_t) phases[gen].rows * sizeof(uint64_t)) == ZERO) { period = gen; }
+        processGs_FoT(&board);
+    }
+    freeGs(&board);
+
+    for(gen = ZERO; gen < period; gen++)
+    {
+        CensusKind *kind = slotFor(census -> known, census -> knownSize, canonicalKey(&phases[gen]));
+
+        if(kind -> key != ZERO) { continue; /* Already named */ }
+        kind -> key = canonicalKey(&phases[gen]);
+        kind -> object = canonicalKey(&phases[ZERO]);
+        kind -> name = pattern -> name;
+        kind -> period = period;
+        kind -> moves = (tops[period] != tops[ZERO] || lefts[period] != lefts[ZERO]);
+    }
+
+return;
+}
+
+int newCensus(Census *census, int threads) /* RETURN 1 => OK! threads < 1 => one per CPU */
+{
+    int i;
+
+    memset(census, ZERO, sizeof(Census));
+    census -> threads = (threads > ZERO) ? threads : (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if(census -> threads < ONE) { census -> threads = ONE; }
+    if(census -> threads > 256) { census -> threads = 256; }
+    census -> knownSize = 1024;
+    if((census -> known = calloc((size_t) census -> knownSize, sizeof(CensusKind))) == NULL || growKinds(census) == ZERO)
+    {
+        freeCensus(census);
+
+    return ZERO;
+    }
+    for(i = ZERO; i < (int) (sizeof(stillLifes) / sizeof(stillLifes[ZERO])); i++) { addKnown(census, &stillLifes[i]); }
+    for(i = ZERO; i < patternCount; i++) { addKnown(census, &patternTable[i]); }
+
+return ONE;
+}
+
+int takeCensus(Census *census, Gs *states) /* RETURN 0 => out of memory */
+{
+    struct labelling all;
+    struct censusJob jobs[256];
+    int strips, i, row, word;
+    uint32_t total = ZERO, id, component;
+
+    memset(&all, ZERO, sizeof(all));
+    all.states = states;
+    strips = states -> rows / MIN_STRIP;
+    if(strips > census -> threads) { strips = census -> threads; }
+    if(strips < ONE) { strips = ONE; }
+    for(i = ZERO; i < strips; i++)
+    {
+        jobs[i].all = &all;
+        jobs[i].firstRow = (int) (((long) states -> rows * i) / strips);
+        jobs[i].lastRow = (int) (((long) states -> rows * (i + ONE)) / strips);
+    }
+
+    /* Live cells per row, then where each row's ids start */
+    if((all.rowFirst = malloc(((size_t) states -> rows + ONE) * sizeof(uint32_t))) == NULL) { return ZERO; }
+    runJobs(jobs, strips, countRows);
+    for(row = ZERO; row < states -> rows; row++)
+    {
+        uint32_t live = all.rowFirst[row];
+
+        if(total + live < total)
+        {/* More than 2^32 live cells */
+            free(all.rowFirst);
+
+        return ZERO;
+        }
+        all.rowFirst[row] = total;
+        total += live;
+    }
+    all.rowFirst[states -> rows] = total;
+
+    all.wordFirst = malloc(gsWords(states -> rows, states -> cols) * sizeof(uint32_t));
+    all.parent = malloc(((size_t) total + ONE) * sizeof(uint32_t));
+    all.label = malloc(((size_t) total + ONE) * sizeof(uint32_t));
+    if(all.wordFirst == NULL || all.parent == NULL || all.label == NULL)
+    {
+        free(all.rowFirst); free(all.wordFirst); free(all.parent); free(all.label);
+
+    return ZERO;
+    }
+
+    /* Union-find: strips in parallel, then the few rows at each seam */
+    runJobs(jobs, strips, labelStrip);
+    for(i = ONE; i < strips; i++)
+    {
+        for(row = jobs[i].firstRow; row < jobs[i].firstRow + CENSUS_GAP && row < states -> rows; row++)
+        {
+            for(word = ZERO; word < states -> words; word++)
+            {
+                uint64_t live = GS_ROW(states, row)[word];
+
+                while(live)
+                {
+                    int col = (word * WORD_BITS) + __builtin_ctzll(live);
+                    int from = (col - CENSUS_GAP < ZERO) ? ZERO : col - CENSUS_GAP;
+                    int to = (col + CENSUS_GAP + ONE > states -> cols) ? states -> cols : col + CENSUS_GAP + ONE, above;
+
+                    for(above = row - ONE; above >= row - CENSUS_GAP && above >= ZERO; above--)
+                    {
+                        uint64_t near;
+
+                        if(above >= jobs[i].firstRow) { continue; /* Same strip, done already */ }
+                        near = rowBits(GS_ROW(states, above), states -> words, from, to);
+                        while(near)
+                        {
+                            join(all.parent, idOf(&all, row, col), idOf(&all, above, from + __builtin_ctzll(near)));
+                            near &= near - ONE;
+                        }
+                    }
+                    live &= live - ONE;
+                }
+            }
+        }
+    }
+    runJobs(jobs, strips, findLabels);
+
+    /* Number the objects (a root is the first cell of its object) and take their bounding boxes */
+    all.components = ZERO;
+    for(id = ZERO; id < total; id++)
+    {
+        if(all.label[id] == id) { all.parent[id] = all.components++; }
+    }
+    all.top = malloc(((size_t) all.components + ONE) * sizeof(uint32_t));
+    all.left = malloc(((size_t) all.components + ONE) * sizeof(uint32_t));
+    all.bottom = malloc(((size_t) all.components + ONE) * sizeof(uint32_t));
+    all.right = malloc(((size_t) all.components + ONE) * sizeof(uint32_t));
+    all.roots = malloc(((size_t) all.components + ONE) * sizeof(uint32_t));
+    all.sizes = malloc(((size_t) all.components + ONE) * sizeof(uint32_t));
+    all.keys = malloc(((size_t) all.components + ONE) * sizeof(uint64_t));
+    if(all.top == NULL || all.left == NULL || all.bottom == NULL || all.right == NULL || all.roots == NULL || all.sizes == NULL || all.keys == NULL)
+    {
+        free(all.rowFirst); free(all.wordFirst); free(all.parent); free(all.label);
+        free(all.top); free(all.left); free(all.bottom); free(all.right); free(all.roots); free(all.sizes); free(all.keys);
+
+    return ZERO;
+    }
+    for(row = ZERO, id = ZERO; row < states -> rows; row++)
+    {
+        for(word = ZERO; word < states -> words; word++)
+        {
+            uint64_t live = GS_ROW(states, row)[word];
+
+            for(; live; live &= live - ONE, id++)
+            {
+                uint32_t col = (uint32_t) ((word * WORD_BITS) + __builtin_ctzll(live));
+
+                component = all.parent[all.label[id]];
+                if(all.label[id] == id)
+                {
+                    all.roots[component] = id;
+                    all.top[component] = all.bottom[component] = (uint32_t) row;
+                    all.left[component] = all.right[component] = col;
+                    all.sizes[component] = ONE;
+                    continue;
+                }
+                all.sizes[component]++;
+                all.bottom[component] = (uint32_t) row;
+                if(col < all.left[component]) { all.left[component] = col; }
+                if(col > all.right[component]) { all.right[component] = col; }
+            }
+        }
+    }
+
+    /* Canonical forms, objects shared out between the threads */
+    for(i = ZERO; i < strips; i++)
+    {
+        jobs[i].firstComponent = (uint32_t) (((uint64_t) all.components * (uint64_t) i) / (uint64_t) strips);
+        jobs[i].lastComponent = (uint32_t) (((uint64_t) all.components * (uint64_t) (i + ONE)) / (uint64_t) strips);
+    }
+    runJobs(jobs, strips, nameComponents);
+
+    /* Tally */
+    memset(census -> kinds, ZERO, (size_t) census -> kindsSize * sizeof(CensusKind));
+    census -> kindCount = ZERO;
+    census -> objects = (long) all.components;
+    census -> oversized = ZERO;
+    for(component = ZERO; component < all.components; component++)
+    {
+        CensusKind *kind, *known;
+        uint64_t key = all.keys[component];
+
+        if(key == ZERO)
+        {
+            census -> oversized++;
+            continue;
+        }
+        known = slotFor(census -> known, census -> knownSize, key);
+        if(known -> key != ZERO) { key = known -> object; /* Any phase => the object */ }
+        if((census -> kindCount + ONE) * TWO > census -> kindsSize && growKinds(census) == ZERO) { break; }
+        kind = slotFor(census -> kinds, census -> kindsSize, key);
+        if(kind -> key == ZERO)
+        {
+            if(known -> key != ZERO)
+            {
+                *kind = *known;
+                kind -> key = key;
+            }
+            else
+            {
+                kind -> key = key;
+                kind -> width = (int) (all.right[component] - all.left[component]) + ONE;
+                kind -> height = (int) (all.bottom[component] - all.top[component]) + ONE;
+                kind -> cells = (int) all.sizes[component];
+            }
+            kind -> count = ZERO;
+            census -> kindCount++;
+        }
+        kind -> count++;
+    }
+
+    free(all.rowFirst); free(all.wordFirst); free(all.parent); free(all.label);
+    free(all.top); free(all.left); free(all.bottom); free(all.right); free(all.roots); free(all.sizes); free(all.keys);
+
+return ONE;
+}
+
+static int byCount(const void *a, const void *b)
+{
+    const CensusKind *first = a, *second = b;
+
+    if(first -> count != second -> count) { return (first -> count < second -> count) ? ONE : -ONE; }
+
+return (first -> key < second -> key) ? -ONE : (first -> key > second -> key);
+}
+
+void printCensus(Census *census, FILE *out, long generation)
+{
+    CensusKind *sorted = malloc(((size_t) census -> kindCount + ONE) * sizeof(CensusKind));
+    char kind[64];
+    int i, count = ZERO;
+
+    fprintf(out, "Census at generation %ld: %ld objects, %d kinds", generation, census -> objects, census -> kindCount);
+    if(census -> oversized) { fprintf(out, ", %ld too big to name", census -> oversized); }
+    fprintf(out, "\n");
+    if(sorted == NULL) { return; }
+
+    for(i = ZERO; i < census -> kindsSize; i++)
+    {
+        if(census -> kinds[i].key != ZERO) { sorted[count++] = census -> kinds[i]; }
+    }
+    qsort(sorted, (size_t) count, sizeof(CensusKind), byCount);
+    for(i = ZERO; i < count; i++)
+    {
+        if(sorted[i].name == NULL) { sprintf(kind, "%d cells, %dx%d, #%08lx", sorted[i].cells, sorted[i].width, sorted[i].height, (unsigned long) (sorted[i].key & 0xffffffffUL)); }
+        else if(sorted[i].moves) { sprintf(kind, "spaceship, period %d", sorted[i].period); }
+        else if(sorted[i].period == ONE) { sprintf(kind, "still life"); }
+        else { sprintf(kind, "oscillator, period %d", sorted[i].period); }
+        fprintf(out, "%10ld  %-18s %s\n", sorted[i].count, sorted[i].name ? sorted[i].name : "unknown", kind);
+    }
+    fflush(out);
+    free(sorted);
+
+return;
+}
+
+void freeCensus(Census *census)
+{
+    free(census -> known);
+    free(census -> kinds);
+    census -> known = NULL;
+    census -> kinds = NULL;
+
+return;
+}
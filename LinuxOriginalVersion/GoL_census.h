@@ -0,0 +1,52 @@
+#ifndef GOL_CENSUS_H
+#define GOL_CENSUS_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Object census: live cells closer than CENSUS_GAP dead cells count as one object
+ * (so a pulsar's four quarters stay together). Objects are labelled with a union-find
+ * run on row strips in parallel, then named by the canonical form of their cells:
+ * the smallest hash over all 8 orientations, looked up among the phases of the
+ * periodic patterns in the pattern table and a few common still lifes.
+ */
+
+#define CENSUS_GAP 2 /* Cells up to 2 apart (1 dead cell between) are joined */
+#define CENSUS_MAX_PERIOD 60 /* Longest period looked for in the known objects */
+
+struct censusKind
+{
+    uint64_t key;     /* Canonical form, 0 => empty slot */
+    uint64_t object;  /* Known objects: key of their first phase, every phase is counted under it */
+    const char *name; /* NULL => not a known object */
+    int period;       /* Known objects: 1 => still life */
+    int moves;        /* Known objects: 1 => spaceship */
+    int cells;        /* Unknown objects: size, for the report */
+    int width;
+    int height;
+    long count;
+};
+typedef struct censusKind CensusKind;
+
+struct census
+{
+    int threads;
+    CensusKind *known; /* Open addressing on key */
+    int knownSize;
+    CensusKind *kinds; /* Tally of the last census, open addressing on key */
+    int kindsSize;
+    int kindCount;
+    long objects;
+    long oversized;    /* Objects too big to name (over 64 x 64) */
+};
+typedef struct census Census;
+
+int newCensus(Census *census, int threads); /* RETURN 1 => OK! threads < 1 => one per CPU */
+int takeCensus(Census *census, Gs *states); /* RETURN 0 => out of memory */
+void printCensus(Census *census, FILE *out, long generation);
+void freeCensus(Census *census);
+
+#endif /* GOL_CENSUS_H */
@@ -0,0 +1,165 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_changes.h"
+
+static int reserve(Changes *changes, size_t need) /* RETURN 1 => OK! */
+{
+    size_t capacity = changes -> capacity ? changes -> capacity : 1024;
+    uint32_t *flips, *next, *candidates;
+
+    if(need <= changes -> capacity) { return ONE; }
+    while(capacity < need) { capacity *= TWO; }
+    if((flips = realloc(changes -> flips, capacity * sizeof(uint32_t))) != NULL) { changes -> flips = flips; }
+    if((next = realloc(changes -> next, capacity * sizeof(uint32_t))) != NULL) { changes -> next = next; }
+    if((candidates = realloc(changes -> candidates, capacity * sizeof(uint32_t))) != NULL) { changes -> candidates = candidates; }
+    if(flips == NULL || next == NULL || candidates == NULL) { return ZERO; }
+    changes -> capacity = capacity;
+
+return ONE;
+}
+
+static void addNeighbours(Changes *changes, uint32_t cell, int delta)
+{
+    unsigned char *count = changes -> counts + cell;
+    size_t cols = (size_t) changes -> cols;
+
+    count[-(long) cols - ONE] += delta; count[-(long) cols] += delta; count[-(long) cols + ONE] += delta;
+    count[-ONE] += delta; count[ONE] += delta;
+    count[cols - ONE] += delta; count[cols] += delta; count[cols + ONE] += delta;
+
+return;
+}
+
+int newChanges(Changes *changes, Gs *states) /* RETURN 1 => OK! */
+{
+    memset(changes, ZERO, sizeof(Changes));
+    if((uint64_t) states -> rows * (uint64_t) states -> cols >= UINT32_MAX) { return ZERO; }
+    changes -> rows = states -> rows;
+    changes -> cols = states -> cols;
+    if((changes -> counts = malloc((size_t) states -> rows * (size_t) states -> cols)) == NULL) { return ZERO; }
+    syncChanges(changes, states);
+    if(changes -> counts == NULL)
+    {
+        freeChanges(changes);
+
+    return ZERO;
+    }
+
+return ONE;
+}
+
+void syncChanges(Changes *changes, Gs *states)
+{/* Counts from scratch, and every live cell counts as a flip so its surroundings get looked at */
+    int row, col, word;
+
+    memset(changes -> counts, ZERO, (size_t) changes -> rows * (size_t) changes -> cols);
+    changes -> flipCount = ZERO;
+    for(row = ONE; row < changes -> rows - ONE; row++)
+    {
+        const uint64_t *cells = GS_ROW(states, row);
+
+        for(word = ZERO; word < states -> words; word++)
+        {
+            uint64_t live = cells[word];
+
+            while(live)
+            {
+                uint32_t cell;
+
+                col = (word * WORD_BITS) + __builtin_ctzll(live);
+                live &= live - ONE;
+                cell = (uint32_t) row * (uint32_t) changes -> cols + (uint32_t) col;
+                addNeighbours(changes, cell, ONE);
+                if(reserve(changes, changes -> flipCount + ONE) == ZERO)
+                {/* newChanges() gives up, stepChanges() would miss cells */
+                    free(changes -> counts);
+                    changes -> counts = NULL;
+
+                return;
+                }
+                changes -> flips[changes -> flipCount++] = cell;
+            }
+        }
+    }
+
+return;
+}
+
+int stepChanges(Changes *changes, Gs *states) /* One generation, RETURN 0 => out of memory */
+{
+    size_t i, candidateCount = ZERO, nextCount = ZERO, cols = (size_t) changes -> cols;
+    size_t most = 9 * changes -> flipCount, cells = (size_t) changes -> rows * cols;
+    uint32_t *swap;
+    int dRow, dCol;
+
+    if(reserve(changes, (most < cells) ? most : cells) == ZERO) { return ZERO; /* Nothing changed yet */ }
+
+    /* Only a flipped cell or one next to a flip can flip now */
+    for(i = ZERO; i < changes -> flipCount; i++)
+    {
+        int row = (int) (changes -> flips[i] / cols), col = (int) (changes -> flips[i] % cols);
+
+        for(dRow = -ONE; dRow <= ONE; dRow++)
+        {
+            if(row + dRow < ONE || row + dRow >= changes -> rows - ONE) { continue; /* Dead edge */ }
+            for(dCol = -ONE; dCol <= ONE; dCol++)
+            {
+                uint32_t cell = (uint32_t) ((size_t) (row + dRow) * cols + (size_t) (col + dCol));
+
+                if(col + dCol < ONE || col + dCol >= changes -> cols - ONE || (changes -> counts[cell] & CHANGE_QUEUED)) { continue; }
+                changes -> counts[cell] |= CHANGE_QUEUED;
+                changes -> candidates[candidateCount++] = cell;
+            }
+        }
+    }
+
+    /* Decide every candidate on the old counts before any of them changes */
+    for(i = ZERO; i < candidateCount; i++)
+    {
+        uint32_t cell = changes -> candidates[i];
+        int row = (int) (cell / cols), col = (int) (cell % cols), live, born;
+
+        changes -> counts[cell] &= (unsigned char) ~CHANGE_QUEUED;
+        live = GET_CELL(states, row, col);
+        born = (changes -> counts[cell] == THREE) || (live && changes -> counts[cell] == TWO);
+        if(born != live) { changes -> next[nextCount++] = cell; }
+    }
+
+    /* Flow of Time: +/-1 to the 8 neighbours of every birth / death */
+    for(i = ZERO; i < nextCount; i++)
+    {
+        uint32_t cell = changes -> next[i];
+        int row = (int) (cell / cols), col = (int) (cell % cols);
+
+        if(GET_CELL(states, row, col))
+        {
+            CLEAR_CELL(states, row, col);
+            addNeighbours(changes, cell, -ONE);
+        }
+        else
+        {
+            SET_CELL(states, row, col);
+            addNeighbours(changes, cell, ONE);
+        }
+        markCell(states, row, col);
+    }
+
+    swap = changes -> flips;
+    changes -> flips = changes -> next;
+    changes -> next = swap;
+    changes -> flipCount = nextCount;
+
+return ONE;
+}
+
+void freeChanges(Changes *changes)
+{
+    free(changes -> counts);
+    free(changes -> flips);
+    free(changes -> next);
+    free(changes -> candidates);
+    memset(changes, ZERO, sizeof(Changes));
+
+return;
+}
@@ -0,0 +1,34 @@
+#ifndef GOL_CHANGES_H
+#define GOL_CHANGES_H
+
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Incremental engine for boards where little happens: every cell keeps its neighbour
+ * count, and a generation only looks at the cells around last generation's flips.
+ * The packed board in Gs stays the real state (gameState1, updated in place).
+ */
+
+#define CHANGE_QUEUED 0x80 /* Flag in counts[]: cell already waits in the candidate list */
+
+struct changeList
+{
+    int rows;
+    int cols;
+    unsigned char *counts; /* Live neighbours per cell (+ CHANGE_QUEUED), rows * cols */
+    uint32_t *flips;       /* Cells (row * cols + col) that flipped last generation */
+    uint32_t *next;        /* Flips of the generation being computed */
+    uint32_t *candidates;  /* Cells that may flip: last flips and their neighbours */
+    size_t flipCount;
+    size_t capacity;       /* Of flips, next & candidates */
+};
+typedef struct changeList Changes;
+
+int newChanges(Changes *changes, Gs *states); /* RETURN 1 => OK! */
+void syncChanges(Changes *changes, Gs *states); /* After the board was edited behind its back */
+int stepChanges(Changes *changes, Gs *states); /* One generation, RETURN 0 => out of memory */
+void freeChanges(Changes *changes);
+
+#endif /* GOL_CHANGES_H */
@@ -0,0 +1,310 @@
+#define _XOPEN_SOURCE   600 /* NEEDED FOR getopt() */
+#define _POSIX_C_SOURCE 200112L
+
+#define SEARCH_BOARDS 4  /* Soups per pattern and margin, each stepped further */
+#define SEARCH_MARGINS 3 /* 0, 1 and 2 dead cells around */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "GoL_board.h"
+#include "GoL_api.h"
+#include "GoL_pyramid.h"
+#include "GoL_search.h"
+#include "../Shared/GoL_patterns.h"
+
+/* Checks the fast paths against plain cell by cell models on random soups: one line per check, exit status 1 if any failed */
+/* Heatmap counters of every engine (through libgol), pattern search in every orientation (with and without a pyramid) */
+
+struct engineCase
+{
+    int engine;
+    const char *rule; /* golSetEngine()'s */
+    const char *name;
+};
+typedef struct engineCase EngineCase;
+
+static const EngineCase heatEngines[] =
+{
+    { GOL_ENGINE_WORDS, NULL, "words" },   /* stepHeat(), counters fused into the step */
+    { GOL_ENGINE_CHANGES, NULL, "changes" }, /* updateHeat() after the other engines */
+    { GOL_ENGINE_LTL, "R1,C0,M0,S2..3,B3..3", "ltl" },
+    { GOL_ENGINE_NOISE, "B0.9,S0.95,N0.001,seed=7", "noise" }
+};
+
+void printUsage(const char *program);
+void soupCells(unsigned char *cells, int rows, int cols, int percent, unsigned seed);
+int checkHeat(int rows, int cols, long generations, int percent, unsigned seed);
+int checkSearch(int rows, int cols, long generations, int percent, unsigned seed);
+long scanGs(Gs *states, const Search *search, const Pattern *pattern, SearchHit *hits, long most);
+int compareHits(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+    long generations = 400;
+    int rows = 150 + TWO, cols = 150 + TWO, percent = 30, failed = ZERO, option;
+    unsigned seed = ONE;
+
+    while((option = getopt(argc, argv, "r:c:d:S:g:")) != -ONE)
+    {
+        if(option == 'r') { rows = atoi(optarg) + TWO; /* + dead edge */ }
+        else if(option == 'c') { cols = atoi(optarg) + TWO; }
+        else if(option == 'd') { percent = atoi(optarg); }
+        else if(option == 'S') { seed = (unsigned) atol(optarg); }
+        else if(option == 'g') { generations = atol(optarg); }
+        else { printUsage(argv[ZERO]); return ONE; }
+    }
+    if(optind != argc || rows < THREE || cols < THREE || percent < ZERO || percent > 100 || generations < ZERO)
+    {
+        printUsage(argv[ZERO]);
+
+    return ONE;
+    }
+
+    failed += checkHeat(rows, cols, generations, percent, seed);
+    failed += checkSearch(rows, cols, generations, percent, seed);
+
+return failed ? ONE : ZERO;
+}
+
+void soupCells(unsigned char *cells, int rows, int cols, int percent, unsigned seed)
+{/* One byte per cell, the dead edge included (golSetRect() ignores it), xorshift so a seed gives the same soup */
+    uint64_t state = ((uint64_t) seed << 32) ^ 0x2545f4914f6cdd1dULL;
+    size_t cell;
+
+    for(cell = ZERO; cell < (size_t) rows * (size_t) cols; cell++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        cells[cell] = (unsigned char) ((int) (state % 100) < percent);
+    }
+
+return;
+}
+
+int checkHeat(int rows, int cols, long generations, int percent, unsigned seed) /* RETURN failed checks */
+{/* golHeatRow() against per cell counters: age = changed ? 0 : age + 1, flips += changed, both stopping at 255 */
+    size_t cells = (size_t) rows * (size_t) cols, cell;
+    unsigned char *before = malloc(cells), *after = malloc(cells), *age = malloc(cells), *flips = malloc(cells);
+    int failed = ZERO, i, row, col;
+    long gen, wrong;
+
+    if(before == NULL || after == NULL || age == NULL || flips == NULL)
+    {
+        printf("%s", "\n*ERROR*\nNot enough memory!\n");
+        free(before); free(after); free(age); free(flips);
+
+    return ONE;
+    }
+    for(i = ZERO; i < (int) (sizeof(heatEngines) / sizeof(heatEngines[ZERO])); i++)
+    {
+        GolBoard *board = golCreate(rows, cols);
+
+        if(board == NULL) { printf("%s", "\n*ERROR*\nNot enough memory!\n"); failed++; continue; }
+        soupCells(before, rows, cols, percent, seed);
+        golSetRect(board, ZERO, ZERO, rows, cols, before, (size_t) cols);
+        if(golSetEngine(board, heatEngines[i].engine, heatEngines[i].rule) == ZERO || golTrackHeat(board, ONE) == ZERO)
+        {
+            printf("heat %-8s FAILED: cannot set up the engine\n", heatEngines[i].name);
+            golDestroy(board);
+            failed++;
+            continue;
+        }
+        golGetRect(board, ZERO, ZERO, rows, cols, before, (size_t) cols);
+        memset(age, 255, cells);
+        memset(flips, ZERO, cells);
+
+        for(gen = ONE, wrong = ZERO; gen <= generations && wrong == ZERO; gen++)
+        {
+            golStep(board, ONE);
+            golGetRect(board, ZERO, ZERO, rows, cols, after, (size_t) cols);
+            for(cell = ZERO; cell < cells; cell++)
+            {
+                if(before[cell] != after[cell]) { age[cell] = ZERO; flips[cell] += (flips[cell] < 255); }
+                else { age[cell] += (age[cell] < 255); }
+            }
+            for(row = ZERO; row < rows && wrong == ZERO; row++)
+            {
+                const unsigned char *ages = golHeatRow(board, GOL_HEAT_AGE, row), *counts = golHeatRow(board, GOL_HEAT_FLIPS, row);
+
+                for(col = ZERO; col < cols; col++)
+                {
+                    if(ages[col] == age[(row * cols) + col] && counts[col] == flips[(row * cols) + col]) { continue; }
+                    printf("heat %-8s FAILED: generation %ld, cell (%d, %d) has age %d flips %d, should be %d and %d\n", heatEngines[i].name, gen, col, row,
+                           ages[col], counts[col], age[(row * cols) + col], flips[(row * cols) + col]);
+                    wrong++;
+                    break;
+                }
+            }
+            memcpy(before, after, cells);
+        }
+        if(wrong == ZERO)
+        {/* Saturated counters are the ones worth seeing */
+            long saturated = ZERO;
+
+            for(cell = ZERO; cell < cells; cell++) { saturated += (flips[cell] == 255); }
+            printf("heat %-8s ok: %ld generations of %dx%d, %ld cells at 255 flips\n", heatEngines[i].name, generations, rows - TWO, cols - TWO, saturated);
+        }
+        failed += (wrong != ZERO);
+        golDestroy(board);
+    }
+    free(before);
+    free(after);
+    free(age);
+    free(flips);
+
+return failed;
+}
+
+int checkSearch(int rows, int cols, long generations, int percent, unsigned seed) /* RETURN failed checks */
+{/* searchGs(), with and without a pyramid, against scanGs() on soups with the pattern stamped in every orientation */
+    unsigned char *cells = malloc((size_t) rows * (size_t) cols);
+    long most = (long) rows * (long) cols * PATTERN_TRANSFORMS, found, scanned, hits = ZERO;
+    SearchHit *expected = malloc((size_t) most * sizeof(SearchHit));
+    int failed = ZERO, p, margin, board, transform, row, col, withPyramid;
+    uint64_t state = ((uint64_t) seed << 32) ^ 0x9e3779b97f4a7c15ULL;
+    Gs states;
+
+    if(cells == NULL || expected == NULL || newGs(&states, rows, cols) == ZERO)
+    {
+        printf("%s", "\n*ERROR*\nNot enough memory!\n");
+        free(cells); free(expected);
+
+    return ONE;
+    }
+    for(p = ZERO; p < patternCount; p++)
+    {
+        for(margin = ZERO; margin < SEARCH_MARGINS; margin++)
+        {
+            Search search;
+            long wrong = ZERO;
+
+            if(newSearch(&search, &patternTable[p], margin) == ZERO) { continue; } /* Too wide with this margin */
+            for(board = ZERO; board < SEARCH_BOARDS && wrong == ZERO; board++)
+            {
+                Pattern oriented;
+                long gen;
+
+                soupCells(cells, rows, cols, board ? percent : ZERO, seed + (unsigned) board); /* The first one empty: tiles get skipped */
+                clearGs(&states);
+                for(row = ONE; row < rows - ONE; row++)
+                {
+                    for(col = ONE; col < cols - ONE; col++) { if(cells[(row * cols) + col]) { SET_CELL(&states, row, col); } }
+                }
+                for(gen = ZERO; gen < board * (generations / SEARCH_BOARDS); gen++) { processGs_FoT(&states); }
+                for(transform = PATTERN_IDENTITY; transform < PATTERN_TRANSFORMS; transform++)
+                {/* Anywhere, over the edge too: some copies are clipped, some overlap others, half of them across a tile corner */
+                    int x, y;
+
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    transformPattern(&patternTable[p], transform, &oriented);
+                    x = (int) ((state >> 8) % (uint64_t) cols) - TWO;
+                    y = (int) ((state >> 40) % (uint64_t) rows) - TWO;
+                    if(state & ONE)
+                    {
+                        x = (x / SEARCH_TILE * SEARCH_TILE) - (int) ((state >> 20) % (uint64_t) oriented.cols);
+                        y = (y / SEARCH_TILE * SEARCH_TILE) - (int) ((state >> 50) % (uint64_t) oriented.rows);
+                    }
+                    stampPattern(states.gameState1, rows, cols, states.words, &oriented, x, y);
+                }
+                deadEdge(&states);
+                scanned = scanGs(&states, &search, &patternTable[p], expected, most);
+                qsort(expected, (size_t) scanned, sizeof(SearchHit), compareHits);
+
+                for(withPyramid = ZERO; withPyramid < TWO && wrong == ZERO; withPyramid++)
+                {
+                    Pyramid pyramid;
+
+                    if(withPyramid && newPyramid(&pyramid, &states) == ZERO) { printf("%s", "\n*ERROR*\nNot enough memory!\n"); wrong++; break; }
+                    found = searchGs(&search, &states, withPyramid ? &pyramid : NULL);
+                    if(found >= ZERO) { qsort(search.hits, (size_t) found, sizeof(SearchHit), compareHits); }
+                    if(found != scanned || (found > ZERO && memcmp(search.hits, expected, (size_t) found * sizeof(SearchHit)) != ZERO))
+                    {
+                        printf("search %s,%d FAILED: soup %d %s the pyramid, %ld hits, the scan finds %ld\n", patternTable[p].name, margin, board,
+                               withPyramid ? "with" : "without", found, scanned);
+                        wrong++;
+                    }
+                    if(withPyramid) { freePyramid(&pyramid); }
+                }
+                hits += scanned;
+            }
+            failed += (wrong != ZERO);
+            freeSearch(&search);
+        }
+    }
+    if(failed == ZERO) { printf("search ok: every pattern, margins 0..%d, %d soups of %dx%d each, %ld hits in all\n", SEARCH_MARGINS - ONE, SEARCH_BOARDS, rows - TWO, cols - TWO, hits); }
+    freeGs(&states);
+    free(cells);
+    free(expected);
+
+return failed;
+}
+
+long scanGs(Gs *states, const Search *search, const Pattern *pattern, SearchHit *hits, long most) /* RETURN hits */
+{/* Every window of every orientation, cell by cell: the pattern's cells as they are, the margin dead, off the board dead */
+    Pattern oriented, seen[PATTERN_TRANSFORMS];
+    int transform, distinct = ZERO, o, row, col, r, c, margin = search -> margin;
+    long count = ZERO;
+
+    for(transform = PATTERN_IDENTITY; transform < PATTERN_TRANSFORMS; transform++)
+    {
+        transformPattern(pattern, transform, &oriented);
+        for(o = ZERO; o < distinct; o++)
+        {/* A symmetric pattern is reported once, under the first orientation that looks like this */
+            if(seen[o].rows == oriented.rows && seen[o].cols == oriented.cols && memcmp(seen[o].bits, oriented.bits, (size_t) oriented.rows * sizeof(uint64_t)) == ZERO) { break; }
+        }
+        if(o < distinct) { continue; }
+        seen[distinct++] = oriented;
+
+        for(row = ZERO; row + oriented.rows <= states -> rows; row++)
+        {
+            for(col = ZERO; col + oriented.cols <= states -> cols; col++)
+            {
+                int match = ONE;
+
+                for(r = -margin; r < oriented.rows + margin && match; r++)
+                {
+                    for(c = -margin; c < oriented.cols + margin && match; c++)
+                    {
+                        int board = (row + r >= ZERO && row + r < states -> rows && col + c >= ZERO && col + c < states -> cols) ? GET_CELL(states, row + r, col + c) : ZERO;
+
+                        match = (board == patternCell(&oriented, r, c));
+                    }
+                }
+                if(!match || count == most) { continue; }
+                hits[count].row = row;
+                hits[count].col = col;
+                hits[count].transform = transform;
+                count++;
+            }
+        }
+    }
+
+return count;
+}
+
+int compareHits(const void *a, const void *b)
+{
+    const SearchHit *x = a, *y = b;
+
+    if(x -> row != y -> row) { return (x -> row < y -> row) ? -ONE : ONE; }
+    if(x -> col != y -> col) { return (x -> col < y -> col) ? -ONE : ONE; }
+
+return (x -> transform > y -> transform) - (x -> transform < y -> transform);
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [-r rows] [-c cols] [-d percent] [-S seed] [-g generations]\n"
+           "  -r, -c  Board size of the soups (default 150x150: a few words and tiles each way, with a tail)\n"
+           "  -d      %% live cells (default 30), -S picks the soup\n"
+           "  -g      Generations per check (default 400, past the 255 where the counters stop), the search's soups are stepped up to it\n",
+           program);
+
+return;
+}
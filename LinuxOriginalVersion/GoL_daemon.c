@@ -0,0 +1,766 @@
+#define _XOPEN_SOURCE   600 /* NEEDED FOR getopt(), poll() & sigaction() */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "GoL_board.h"
+#include "GoL_protocol.h"
+#include "GoL_pyramid.h"
+#include "../Shared/GoL_patterns.h"
+
+/*
+ * Simulation daemon: many boards (sessions) served over a Unix domain socket, see GoL_protocol.h.
+ * One I/O thread polls every connection, GOL_STEP is handed to a pool of workers which
+ * step each session SLICE_CELLS cell updates at a time, so a huge board cannot starve small ones:
+ * small boards run whole generations per slice, a board bigger than that a band of rows.
+ */
+
+#define MAX_CLIENTS 64
+#define SLICE_CELLS (1L << 24) /* Cell updates per time slice */
+#define OUT_HIGH (8u << 20) /* Stop reading requests from a client that does not read its replies */
+#define IN_LIMIT (sizeof(struct golRequest) + GOL_MAX_PAYLOAD) /* The largest request, a client's input buffer never grows past it */
+#define READS_PER_POLL 16 /* Then the other clients get their turn */
+
+struct session
+{
+    uint32_t id;
+    uint64_t *arena; /* gameState1, gameState2 & base in one allocation */
+    uint64_t *base; /* Board when the last GOL_STEP began, for GOL_DELTA */
+    Gs states;
+    Pyramid pyramid; /* Built by the first GOL_REGION, levels 0 => none */
+    uint64_t generation;
+    uint32_t pending; /* Generations still to step, only touched by the workers while > 0 */
+    long quantum; /* Generations per time slice */
+    int bandRows; /* Rows per time slice, fewer than the board's => a generation takes several slices */
+    int nextRow; /* First row of the next band, 1 => between generations */
+    struct session *next; /* Sessions of the client */
+    struct session *nextRun; /* Run queue / finished list */
+};
+typedef struct session Session;
+
+struct client
+{
+    int fd; /* -1 => slot free */
+    int closing; /* Peer gone while a step was running, freed when it finishes */
+    Session *busy; /* Session of the running GOL_STEP, no more requests are read until it is done */
+    Session *sessions;
+    unsigned char *in, *out;
+    size_t inHave, inCapacity, outHave, outSent, outCapacity;
+};
+typedef struct client Client;
+
+struct scheduler
+{
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    Session *runHead, *runTail; /* Sessions waiting for a worker */
+    Session *finished; /* Steps done, replied to by the I/O thread */
+    int wake[TWO]; /* Pipe, the workers write a byte when something finished */
+    int stop;
+};
+
+static struct scheduler sched;
+static Client clients[MAX_CLIENTS];
+static uint32_t lastSession = ZERO;
+static volatile sig_atomic_t quit = ZERO;
+
+void printUsage(const char *program);
+void onSignal(int signal);
+int listenOn(const char *path);
+void *worker(void *unused);
+void runSession(Session *session);
+void acceptClient(int listener);
+void readClient(Client *client);
+void writeClient(Client *client);
+void serveClient(Client *client);
+void handleRequest(Client *client, const struct golRequest *request, const unsigned char *payload);
+void reply(Client *client, int32_t status, const void *payload, uint32_t length);
+void finishSteps(void);
+Session *newSession(uint32_t rows, uint32_t cols);
+Session *findSession(Client *client, uint32_t id);
+void dropSession(Client *client, Session *session);
+void closeClient(Client *client);
+void freeClient(Client *client);
+
+int main(int argc, char *argv[])
+{
+    const char *path = GOL_SOCKET;
+    struct pollfd waitFor[TWO + MAX_CLIENTS];
+    Client *polled[TWO + MAX_CLIENTS];
+    struct sigaction action;
+    pthread_t *workers;
+    long workerCount = sysconf(_SC_NPROCESSORS_ONLN);
+    int listener, option, i, count;
+
+    while((option = getopt(argc, argv, "S:w:")) != -ONE)
+    {
+        if(option == 'S') { path = optarg; }
+        else if(option == 'w') { workerCount = atol(optarg); }
+        else { printUsage(argv[ZERO]); return ONE; }
+    }
+    if(workerCount < ONE) { workerCount = ONE; }
+
+    memset(&action, ZERO, sizeof(action));
+    action.sa_handler = onSignal; /* No SA_RESTART, poll() returns with EINTR */
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN); /* A client that went away shows up as EPIPE */
+
+    if((listener = listenOn(path)) < ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nCannot listen on ", path, " (or another daemon is serving it)!\n");
+
+    return ONE;
+    }
+    for(i = ZERO; i < MAX_CLIENTS; i++) { clients[i].fd = -ONE; }
+
+    pthread_mutex_init(&sched.lock, NULL);
+    pthread_cond_init(&sched.work, NULL);
+    if(pipe(sched.wake) != ZERO || (workers = malloc((size_t) workerCount * sizeof(pthread_t))) == NULL)
+    {
+        printf("%s", "\n*ERROR*\nCannot start the workers!\n");
+        close(listener);
+        unlink(path);
+
+    return ONE;
+    }
+    fcntl(sched.wake[ZERO], F_SETFL, O_NONBLOCK);
+    fcntl(sched.wake[ONE], F_SETFL, O_NONBLOCK);
+    for(i = ZERO; i < workerCount; i++) { pthread_create(&workers[i], NULL, worker, NULL); }
+    printf("GoL_daemon: %s, %ld workers\n", path, workerCount);
+    fflush(stdout);
+
+    while(!quit)
+    {
+        waitFor[ZERO].fd = listener;
+        waitFor[ZERO].events = POLLIN;
+        waitFor[ONE].fd = sched.wake[ZERO];
+        waitFor[ONE].events = POLLIN;
+        count = TWO;
+        for(i = ZERO; i < MAX_CLIENTS; i++)
+        {
+            Client *client = &clients[i];
+
+            if(client -> fd < ZERO) { continue; }
+            waitFor[count].fd = client -> fd;
+            waitFor[count].events = ZERO;
+            if(client -> busy == NULL && client -> outHave < OUT_HIGH) { waitFor[count].events |= POLLIN; }
+            if(client -> outHave > client -> outSent) { waitFor[count].events |= POLLOUT; }
+            polled[count++] = client;
+        }
+
+        if(poll(waitFor, (nfds_t) count, -ONE) < ZERO)
+        {
+            if(errno == EINTR) { continue; }
+            break;
+        }
+
+        if(waitFor[ONE].revents) { finishSteps(); }
+        for(i = TWO; i < count; i++)
+        {
+            if(polled[i] -> fd < ZERO) { continue; }
+            if(waitFor[i].revents & POLLOUT)
+            {/* Requests held back by OUT_HIGH go on once the replies drain */
+                writeClient(polled[i]);
+                if(polled[i] -> fd >= ZERO && polled[i] -> busy == NULL && polled[i] -> inHave) { serveClient(polled[i]); }
+            }
+            if(polled[i] -> fd >= ZERO && (waitFor[i].revents & (POLLHUP | POLLERR)) && polled[i] -> inCapacity && polled[i] -> inHave == polled[i] -> inCapacity)
+            {/* Gone with a full buffer: read() would never see the EOF and poll() would keep returning the hangup */
+                closeClient(polled[i]);
+                continue;
+            }
+            if(polled[i] -> fd >= ZERO && (waitFor[i].revents & (POLLIN | POLLHUP | POLLERR))) { readClient(polled[i]); }
+        }
+        if(waitFor[ZERO].revents & POLLIN) { acceptClient(listener); }
+    }
+
+    /* Shut down: workers first, so no session is freed under them */
+    pthread_mutex_lock(&sched.lock);
+    sched.stop = ONE;
+    pthread_cond_broadcast(&sched.work);
+    pthread_mutex_unlock(&sched.lock);
+    for(i = ZERO; i < workerCount; i++) { pthread_join(workers[i], NULL); }
+    for(i = ZERO; i < MAX_CLIENTS; i++)
+    {
+        if(clients[i].fd >= ZERO) { close(clients[i].fd); }
+        if(clients[i].fd >= ZERO || clients[i].closing) { freeClient(&clients[i]); }
+    }
+    free(workers);
+    close(listener);
+    unlink(path);
+
+return ZERO;
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [-S socket] [-w workers]\n"
+           "  -S      Unix socket to listen on (default %s)\n"
+           "  -w      Worker threads stepping the boards (default: one per CPU)\n",
+           program, GOL_SOCKET);
+
+return;
+}
+
+void onSignal(int signal)
+{
+    (void) signal;
+    quit = ONE;
+
+return;
+}
+
+int listenOn(const char *path)
+{
+    struct sockaddr_un address;
+    int listener;
+
+    if(strlen(path) >= sizeof(address.sun_path)) { return -ONE; }
+    memset(&address, ZERO, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    if((listener = socket(AF_UNIX, SOCK_STREAM, ZERO)) < ZERO) { return -ONE; }
+    if(connect(listener, (struct sockaddr *) &address, sizeof(address)) == ZERO)
+    {/* A daemon is serving it: leave it be */
+        close(listener);
+
+    return -ONE;
+    }
+    close(listener);
+    if((listener = socket(AF_UNIX, SOCK_STREAM, ZERO)) < ZERO) { return -ONE; }
+    unlink(path); /* Left over by a daemon that was killed */
+    if(bind(listener, (struct sockaddr *) &address, sizeof(address)) != ZERO || listen(listener, MAX_CLIENTS) != ZERO)
+    {
+        close(listener);
+
+    return -ONE;
+    }
+    fcntl(listener, F_SETFL, O_NONBLOCK);
+
+return listener;
+}
+
+void *worker(void *unused)
+{
+    Session *session;
+
+    (void) unused;
+    while(ONE)
+    {
+        pthread_mutex_lock(&sched.lock);
+        while(sched.runHead == NULL && !sched.stop) { pthread_cond_wait(&sched.work, &sched.lock); }
+        if(sched.stop)
+        {
+            pthread_mutex_unlock(&sched.lock);
+            break;
+        }
+        session = sched.runHead;
+        sched.runHead = session -> nextRun;
+        if(sched.runHead == NULL) { sched.runTail = NULL; }
+        pthread_mutex_unlock(&sched.lock);
+
+        runSession(session);
+    }
+
+return NULL;
+}
+
+void runSession(Session *session)
+{/* One time slice, then back to the end of the queue (or to the I/O thread when done) */
+    Gs *states = &session -> states;
+    long gen, slice = (session -> pending < session -> quantum) ? (long) session -> pending : session -> quantum;
+
+    if(session -> bandRows < states -> rows - TWO)
+    {/* gameState1 is only read until the swap, so one generation can be stepped a band at a time */
+        size_t words = (size_t) states -> words;
+        int row, last = session -> nextRow + session -> bandRows;
+        uint64_t *swap;
+
+        if(last > states -> rows - ONE) { last = states -> rows - ONE; }
+        for(row = session -> nextRow; row < last; row++)
+        {
+            processRow(states -> gameState1 + ((row - ONE) * words), states -> gameState1 + (row * words),
+                       states -> gameState1 + ((row + ONE) * words), states -> gameState2 + (row * words), states -> words);
+            markWords(states, row, states -> gameState1 + (row * words), states -> gameState2 + (row * words));
+        }
+        session -> nextRow = last;
+        slice = ZERO;
+        if(last == states -> rows - ONE)
+        {/* Flow of Time, as processGs_FoT() */
+            swap = states -> gameState1;
+            states -> gameState1 = states -> gameState2;
+            states -> gameState2 = swap;
+            deadEdge(states);
+            session -> nextRow = ONE;
+            slice = ONE;
+        }
+    }
+    else { for(gen = ZERO; gen < slice; gen++) { processGs_FoT(states); } }
+    session -> generation += (uint64_t) slice;
+    session -> pending -= (uint32_t) slice;
+
+    pthread_mutex_lock(&sched.lock);
+    if(session -> pending > ZERO)
+    {
+        session -> nextRun = NULL;
+        if(sched.runTail != NULL) { sched.runTail -> nextRun = session; }
+        else { sched.runHead = session; }
+        sched.runTail = session;
+        pthread_cond_signal(&sched.work);
+    }
+    else
+    {
+        session -> nextRun = sched.finished;
+        sched.finished = session;
+        if(write(sched.wake[ONE], "", ONE) < ZERO) { /* Pipe full, the I/O thread is woken anyway */ }
+    }
+    pthread_mutex_unlock(&sched.lock);
+
+return;
+}
+
+void finishSteps(void)
+{
+    char drain[64];
+    Session *session, *next;
+    int i;
+
+    while(read(sched.wake[ZERO], drain, sizeof(drain)) > ZERO) { /* Empty the pipe */ }
+    pthread_mutex_lock(&sched.lock);
+    session = sched.finished;
+    sched.finished = NULL;
+    pthread_mutex_unlock(&sched.lock);
+
+    for(; session != NULL; session = next)
+    {
+        next = session -> nextRun;
+        for(i = ZERO; i < MAX_CLIENTS; i++)
+        {
+            Client *client = &clients[i];
+
+            if(client -> busy != session) { continue; }
+            client -> busy = NULL;
+            if(client -> closing) { freeClient(client); }
+            else
+            {
+                reply(client, GOL_OK, &session -> generation, sizeof(uint64_t));
+                serveClient(client); /* Requests that came in behind the step */
+            }
+            break;
+        }
+    }
+
+return;
+}
+
+void acceptClient(int listener)
+{
+    int fd, i;
+
+    while((fd = accept(listener, NULL, NULL)) >= ZERO)
+    {
+        for(i = ZERO; i < MAX_CLIENTS && (clients[i].fd >= ZERO || clients[i].closing); i++) { /* Free slot */ }
+        if(i == MAX_CLIENTS)
+        {
+            close(fd);
+            continue;
+        }
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        memset(&clients[i], ZERO, sizeof(Client));
+        clients[i].fd = fd;
+    }
+
+return;
+}
+
+void readClient(Client *client)
+{/* Complete requests are served as they come in, the buffer only ever holds one largest request */
+    ssize_t got;
+    int reads;
+
+    for(reads = ZERO; reads < READS_PER_POLL; reads++)
+    {
+        if(client -> inCapacity - client -> inHave < 4096 && client -> inCapacity < IN_LIMIT)
+        {
+            size_t capacity = client -> inCapacity ? client -> inCapacity * TWO : 65536;
+
+            if(capacity > IN_LIMIT) { capacity = IN_LIMIT; }
+            unsigned char *in = realloc(client -> in, capacity);
+
+            if(in == NULL)
+            {
+                closeClient(client);
+
+            return;
+            }
+            client -> in = in;
+            client -> inCapacity = capacity;
+        }
+        if(client -> inHave == client -> inCapacity) { break; } /* Full: its request waits for the workers or for the replies to be read */
+        got = read(client -> fd, client -> in + client -> inHave, client -> inCapacity - client -> inHave);
+        if(got > ZERO)
+        {
+            client -> inHave += (size_t) got;
+            serveClient(client);
+            if(client -> fd < ZERO) { return; }
+            continue;
+        }
+        if(got < ZERO && errno == EINTR) { continue; }
+        if(got < ZERO && (errno == EAGAIN || errno == EWOULDBLOCK)) { break; }
+        closeClient(client); /* EOF or error */
+
+    return;
+    }
+
+return;
+}
+
+void writeClient(Client *client)
+{
+    ssize_t sent;
+
+    while(client -> outSent < client -> outHave)
+    {
+        sent = write(client -> fd, client -> out + client -> outSent, client -> outHave - client -> outSent);
+        if(sent > ZERO) { client -> outSent += (size_t) sent; }
+        else if(sent < ZERO && errno == EINTR) { continue; }
+        else if(sent < ZERO && (errno == EAGAIN || errno == EWOULDBLOCK)) { return; }
+        else
+        {
+            closeClient(client);
+
+        return;
+        }
+    }
+    client -> outHave = client -> outSent = ZERO;
+
+return;
+}
+
+void serveClient(Client *client)
+{/* Every complete request in the input buffer, in order, until one has to wait for the workers or for replies to be read */
+    struct golRequest request;
+    size_t used = ZERO;
+
+    while(client -> fd >= ZERO && client -> busy == NULL && client -> outHave < OUT_HIGH && client -> inHave - used >= sizeof(request))
+    {
+        memcpy(&request, client -> in + used, sizeof(request));
+        if(request.length > GOL_MAX_PAYLOAD)
+        {/* Cannot find the next request after this one */
+            reply(client, GOL_BAD_REQUEST, NULL, ZERO);
+            writeClient(client);
+            closeClient(client);
+
+        return;
+        }
+        if(client -> inHave - used < sizeof(request) + request.length) { break; }
+        handleRequest(client, &request, client -> in + used + sizeof(request));
+        used += sizeof(request) + request.length;
+    }
+    if(client -> fd < ZERO) { return; }
+    if(used)
+    {/* A partly read request moves to the front */
+        memmove(client -> in, client -> in + used, client -> inHave - used);
+        client -> inHave -= used;
+    }
+    if(client -> outHave > client -> outSent) { writeClient(client); }
+
+return;
+}
+
+void handleRequest(Client *client, const struct golRequest *request, const unsigned char *payload)
+{
+    uint32_t length = request -> length, args[THREE];
+    int32_t area[FOUR];
+    uint64_t counts[TWO];
+    Session *session = NULL;
+    Gs *states;
+    int row, col, i;
+
+    if(request -> op == GOL_CREATE)
+    {
+        if(length != TWO * sizeof(uint32_t)) { reply(client, GOL_BAD_REQUEST, NULL, ZERO); return; }
+        memcpy(args, payload, TWO * sizeof(uint32_t));
+        if(args[ZERO] < THREE || args[ONE] < THREE || args[ZERO] > (ONE << 24) || args[ONE] > (ONE << 24))
+        {
+            reply(client, GOL_BAD_REQUEST, NULL, ZERO);
+
+        return;
+        }
+        if((session = newSession(args[ZERO], args[ONE])) == NULL) { reply(client, GOL_NO_MEMORY, NULL, ZERO); return; }
+        session -> next = client -> sessions;
+        client -> sessions = session;
+        reply(client, GOL_OK, &session -> id, sizeof(uint32_t));
+
+    return;
+    }
+
+    if((session = findSession(client, request -> session)) == NULL) { reply(client, GOL_NO_SESSION, NULL, ZERO); return; }
+    states = &session -> states;
+
+    if(request -> op == GOL_DESTROY)
+    {
+        dropSession(client, session);
+        reply(client, GOL_OK, NULL, ZERO);
+    }
+    else if(request -> op == GOL_CLEAR)
+    {
+        clearGs(states);
+        reply(client, GOL_OK, NULL, ZERO);
+    }
+    else if(request -> op == GOL_PATTERN || request -> op == GOL_SET_CELLS)
+    {
+        int fixed = (request -> op == GOL_PATTERN) ? THREE : TWO;
+        int *xy;
+
+        if(length < fixed * sizeof(uint32_t)) { reply(client, GOL_BAD_REQUEST, NULL, ZERO); return; }
+        memcpy(args, payload, (size_t) fixed * sizeof(uint32_t));
+        if(length != fixed * sizeof(uint32_t) + (uint64_t) args[fixed - ONE] * TWO * sizeof(int32_t)
+           || (request -> op == GOL_PATTERN && (args[ZERO] >= (uint32_t) patternCount || args[ONE] >= PATTERN_TRANSFORMS)))
+        {
+            reply(client, GOL_BAD_REQUEST, NULL, ZERO);
+
+        return;
+        }
+        if((xy = malloc(((size_t) args[fixed - ONE] * TWO + ONE) * sizeof(int))) == NULL) { reply(client, GOL_NO_MEMORY, NULL, ZERO); return; }
+        for(i = ZERO; i < (int) args[fixed - ONE] * TWO; i++)
+        {
+            int32_t value;
+
+            memcpy(&value, payload + (fixed * sizeof(uint32_t)) + ((size_t) i * sizeof(int32_t)), sizeof(int32_t));
+            xy[i] = value;
+        }
+
+        if(request -> op == GOL_PATTERN)
+        {
+            Pattern oriented;
+
+            transformPattern(&patternTable[args[ZERO]], (int) args[ONE], &oriented);
+            stampPatternMany(states -> gameState1, states -> rows, states -> cols, states -> words, &oriented, xy, (int) args[TWO]);
+            deadEdge(states);
+            markAll(states);
+        }
+        else
+        {
+            for(i = ZERO; i < (int) args[ONE]; i++)
+            {
+                col = xy[TWO * i];
+                row = xy[(TWO * i) + ONE];
+                if(row < ONE || row >= states -> rows - ONE || col < ONE || col >= states -> cols - ONE) { continue; /* Dead edge / outside */ }
+                if(args[ZERO]) { SET_CELL(states, row, col); }
+                else { CLEAR_CELL(states, row, col); }
+                markCell(states, row, col);
+            }
+        }
+        free(xy);
+        reply(client, GOL_OK, NULL, ZERO);
+    }
+    else if(request -> op == GOL_STEP)
+    {
+        if(length != sizeof(uint32_t)) { reply(client, GOL_BAD_REQUEST, NULL, ZERO); return; }
+        memcpy(args, payload, sizeof(uint32_t));
+        memcpy(session -> base, states -> gameState1, gsWords(states -> rows, states -> cols) * sizeof(uint64_t));
+        if(args[ZERO] == ZERO) { reply(client, GOL_OK, &session -> generation, sizeof(uint64_t)); return; }
+
+        session -> pending = args[ZERO];
+        client -> busy = session;
+        pthread_mutex_lock(&sched.lock);
+        session -> nextRun = NULL;
+        if(sched.runTail != NULL) { sched.runTail -> nextRun = session; }
+        else { sched.runHead = session; }
+        sched.runTail = session;
+        pthread_cond_signal(&sched.work);
+        pthread_mutex_unlock(&sched.lock);
+    }
+    else if(request -> op == GOL_POPULATION)
+    {
+        counts[ZERO] = (uint64_t) numOfL(states);
+        counts[ONE] = session -> generation;
+        reply(client, GOL_OK, counts, sizeof(counts));
+    }
+    else if(request -> op == GOL_REGION)
+    {
+        int fromRow, toRow, fromCol, toCol;
+
+        if(length != sizeof(area)) { reply(client, GOL_BAD_REQUEST, NULL, ZERO); return; }
+        memcpy(area, payload, sizeof(area));
+        if(session -> pyramid.levels || newPyramid(&session -> pyramid, states))
+        {/* Brought up to date with the board, then whole blocks are single sums */
+            counts[ZERO] = regionCount(&session -> pyramid, states, area[ZERO], area[ONE], area[TWO], area[THREE]);
+            reply(client, GOL_OK, counts, sizeof(uint64_t));
+
+        return;
+        }
+        /* No room for the sums: clipped to the board, in 64 bit so x + width cannot overflow */
+        fromCol = (int) ((area[ZERO] < ZERO) ? ZERO : (area[ZERO] > states -> cols ? states -> cols : area[ZERO]));
+        fromRow = (int) ((area[ONE] < ZERO) ? ZERO : (area[ONE] > states -> rows ? states -> rows : area[ONE]));
+        toCol = (int) (((int64_t) area[ZERO] + area[TWO] > states -> cols) ? states -> cols : ((int64_t) area[ZERO] + area[TWO] < fromCol ? fromCol : area[ZERO] + area[TWO]));
+        toRow = (int) (((int64_t) area[ONE] + area[THREE] > states -> rows) ? states -> rows : ((int64_t) area[ONE] + area[THREE] < fromRow ? fromRow : area[ONE] + area[THREE]));
+        counts[ZERO] = ZERO;
+        for(row = fromRow; row < toRow; row++) { counts[ZERO] += (uint64_t) countRange(GS_ROW(states, row), fromCol, toCol); }
+        reply(client, GOL_OK, counts, sizeof(uint64_t));
+    }
+    else if(request -> op == GOL_READ)
+    {
+        if(length != TWO * sizeof(int32_t)) { reply(client, GOL_BAD_REQUEST, NULL, ZERO); return; }
+        memcpy(area, payload, TWO * sizeof(int32_t));
+        if(area[ZERO] < ZERO || area[ONE] < ZERO || (int64_t) area[ZERO] + area[ONE] > states -> rows
+           || (uint64_t) area[ONE] * (uint64_t) states -> words * sizeof(uint64_t) > GOL_MAX_PAYLOAD)
+        {
+            reply(client, GOL_BAD_REQUEST, NULL, ZERO);
+
+        return;
+        }
+        reply(client, GOL_OK, GS_ROW(states, area[ZERO]), (uint32_t) ((size_t) area[ONE] * (size_t) states -> words * sizeof(uint64_t)));
+    }
+    else if(request -> op == GOL_DELTA)
+    {/* Words that differ from the base, as (row, word, flipped bits) */
+        size_t word, words = gsWords(states -> rows, states -> cols), changed = ZERO;
+        unsigned char *delta, *out;
+
+        for(word = ZERO; word < words; word++) { changed += (states -> gameState1[word] != session -> base[word]); }
+        if(changed * 16 > GOL_MAX_PAYLOAD) { reply(client, GOL_BAD_REQUEST, NULL, ZERO); return; }
+        if((delta = malloc(changed * 16 + ONE)) == NULL) { reply(client, GOL_NO_MEMORY, NULL, ZERO); return; }
+        out = delta;
+        for(word = ZERO; word < words; word++)
+        {
+            uint64_t flipped = states -> gameState1[word] ^ session -> base[word];
+            uint32_t where[TWO];
+
+            if(flipped == ZERO) { continue; }
+            where[ZERO] = (uint32_t) (word / (size_t) states -> words);
+            where[ONE] = (uint32_t) (word % (size_t) states -> words);
+            memcpy(out, where, sizeof(where));
+            memcpy(out + 8, &flipped, sizeof(flipped));
+            out += 16;
+        }
+        reply(client, GOL_OK, delta, (uint32_t) (changed * 16));
+        free(delta);
+    }
+    else { reply(client, GOL_BAD_REQUEST, NULL, ZERO); }
+
+return;
+}
+
+void reply(Client *client, int32_t status, const void *payload, uint32_t length)
+{
+    struct golReply header;
+    size_t need;
+
+    if(client -> outSent > ZERO)
+    {/* Drop what was already sent */
+        memmove(client -> out, client -> out + client -> outSent, client -> outHave - client -> outSent);
+        client -> outHave -= client -> outSent;
+        client -> outSent = ZERO;
+    }
+    need = client -> outHave + sizeof(header) + length;
+    if(need > client -> outCapacity)
+    {
+        size_t capacity = client -> outCapacity ? client -> outCapacity : 65536;
+        unsigned char *out;
+
+        while(capacity < need) { capacity *= TWO; }
+        if((out = realloc(client -> out, capacity)) == NULL)
+        {
+            closeClient(client);
+
+        return;
+        }
+        client -> out = out;
+        client -> outCapacity = capacity;
+    }
+
+    header.status = status;
+    header.length = length;
+    memcpy(client -> out + client -> outHave, &header, sizeof(header));
+    if(length > ZERO) { memcpy(client -> out + client -> outHave + sizeof(header), payload, length); }
+    client -> outHave = need;
+
+return;
+}
+
+Session *newSession(uint32_t rows, uint32_t cols)
+{/* One arena per session: both boards and the GOL_DELTA base */
+    size_t words = gsWords((int) rows, (int) cols);
+    Session *session = malloc(sizeof(Session));
+
+    if(session == NULL) { return NULL; }
+    if((session -> arena = malloc(THREE * words * sizeof(uint64_t))) == NULL)
+    {
+        free(session);
+
+    return NULL;
+    }
+    placeGs(&session -> states, (int) rows, (int) cols, session -> arena);
+    session -> base = session -> arena + (TWO * words);
+    memset(session -> base, DEAD, words * sizeof(uint64_t));
+    session -> id = ++lastSession;
+    session -> generation = ZERO;
+    session -> pending = ZERO;
+    session -> quantum = SLICE_CELLS / ((long) rows * (long) cols);
+    if(session -> quantum < ONE) { session -> quantum = ONE; }
+    session -> bandRows = (int) (SLICE_CELLS / (long) cols);
+    if(session -> bandRows < ONE) { session -> bandRows = ONE; }
+    session -> nextRow = ONE;
+    session -> pyramid.levels = ZERO;
+    session -> next = NULL;
+    session -> nextRun = NULL;
+
+return session;
+}
+
+Session *findSession(Client *client, uint32_t id)
+{/* Sessions are private to the connection that created them */
+    Session *session;
+
+    for(session = client -> sessions; session != NULL && session -> id != id; session = session -> next) { /* Search */ }
+
+return session;
+}
+
+void dropSession(Client *client, Session *session)
+{
+    Session **link;
+
+    for(link = &client -> sessions; *link != session; link = &(*link) -> next) { /* Search */ }
+    *link = session -> next;
+    if(session -> pyramid.levels) { freePyramid(&session -> pyramid); }
+    untrackGs(&session -> states);
+    free(session -> arena);
+    free(session);
+
+return;
+}
+
+void closeClient(Client *client)
+{/* A worker may still be stepping one of its sessions, then freeing waits for finishSteps() */
+    close(client -> fd);
+    client -> fd = -ONE;
+    if(client -> busy != NULL) { client -> closing = ONE; }
+    else { freeClient(client); }
+
+return;
+}
+
+void freeClient(Client *client)
+{
+    while(client -> sessions != NULL) { dropSession(client, client -> sessions); }
+    free(client -> in);
+    free(client -> out);
+    memset(client, ZERO, sizeof(Client));
+    client -> fd = -ONE;
+
+return;
+}
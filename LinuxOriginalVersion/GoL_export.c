@@ -0,0 +1,157 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "GoL_export.h"
+
+static const char *formatNames[] = { "raw1", "raw8", "pbm", "ppm", "pgm" };
+
+/* expandByte[b][i] = 255 if bit i of b is set: 8 cells => 8 gray bytes with one memcpy */
+static unsigned char expandByte[256][8];
+
+int exportFormatFromName(const char *name)
+{
+    int format;
+
+    for(format = EXPORT_RAW1; format <= EXPORT_PGM; format++) { if(strcmp(formatNames[format], name) == ZERO) { return format; } }
+
+return -ONE;
+}
+
+int openExport(FrameExport *frames, const char *path, int format, int every, Gs *states) /* RETURN 1 => OK! */
+{
+    char header[64];
+    size_t rowBytes;
+    int byte, bit;
+
+    frames -> format = format;
+    frames -> every = (every < ONE) ? ONE : every;
+    frames -> width = states -> cols - TWO;
+    frames -> height = states -> rows - TWO;
+    frames -> heat = NULL;
+    frames -> heatKind = HEAT_AGE;
+
+    if(format == EXPORT_PBM) { frames -> header = (size_t) sprintf(header, "P4\n%d %d\n", frames -> width, frames -> height); }
+    else if(format == EXPORT_PPM) { frames -> header = (size_t) sprintf(header, "P6\n%d %d\n255\n", frames -> width, frames -> height); }
+    else if(format == EXPORT_PGM) { frames -> header = (size_t) sprintf(header, "P5\n%d %d\n255\n", frames -> width, frames -> height); }
+    else { frames -> header = ZERO; }
+
+    if(format == EXPORT_RAW1 || format == EXPORT_PBM) { rowBytes = ((size_t) frames -> width + 7) / 8; }
+    else if(format == EXPORT_RAW8 || format == EXPORT_PGM) { rowBytes = (size_t) frames -> width; }
+    else { rowBytes = (size_t) frames -> width * THREE; }
+    frames -> bytes = frames -> header + (rowBytes * (size_t) frames -> height);
+
+    /* Room for a whole 8 byte (or 24 byte) group past the end of the last row */
+    if((frames -> buffer = malloc(frames -> bytes + 32)) == NULL) { return ZERO; }
+    memcpy(frames -> buffer, header, frames -> header);
+
+    for(byte = ZERO; byte < 256; byte++) { for(bit = ZERO; bit < 8; bit++) { expandByte[byte][bit] = ((byte >> bit) & ONE) ? 255 : ZERO; } }
+
+    if(strcmp(path, "-") == ZERO)
+    {/* Frames take over stdout, everything printed from now on goes to stderr */
+        fflush(stdout);
+        frames -> fd = dup(STDOUT_FILENO);
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+    }
+    else { frames -> fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644); }
+
+    if(frames -> fd < ZERO)
+    {
+        free(frames -> buffer);
+        frames -> buffer = NULL;
+
+    return ZERO;
+    }
+
+return ONE;
+}
+
+static uint64_t cellsAt(const uint64_t *row, int words, int col)
+{/* 64 cells starting at col, cell col => bit 0 */
+    int word = col / WORD_BITS, shift = col % WORD_BITS;
+    uint64_t bits = row[word] >> shift;
+
+    if(shift && (word + ONE) < words) { bits |= row[word + ONE] << (WORD_BITS - shift); }
+
+return bits;
+}
+
+static uint64_t msbFirst(uint64_t bits)
+{/* Reverse the bits inside every byte, so the leftmost cell ends up in the MSB */
+    bits = ((bits >> 1) & 0x5555555555555555ULL) | ((bits & 0x5555555555555555ULL) << 1);
+    bits = ((bits >> 2) & 0x3333333333333333ULL) | ((bits & 0x3333333333333333ULL) << 2);
+    bits = ((bits >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((bits & 0x0f0f0f0f0f0f0f0fULL) << 4);
+
+return bits;
+}
+
+int exportGs(FrameExport *frames, Gs *states, long generation) /* RETURN 0 => write failed */
+{
+    unsigned char *out = frames -> buffer + frames -> header;
+    size_t written = ZERO;
+    int row, col;
+
+    if(generation % frames -> every) { return ONE; }
+
+    for(row = ONE; row <= frames -> height && frames -> format == EXPORT_PGM; row++)
+    {/* A gray byte per cell straight from the counters */
+        for(col = ONE; col <= frames -> width; col++) { *out++ = (frames -> heat == NULL) ? ZERO : (unsigned char) HEAT_AT(frames -> heat, frames -> heatKind, row, col); }
+    }
+    for(row = ONE; row <= frames -> height && frames -> format != EXPORT_PGM; row++)
+    {
+        const uint64_t *cells = GS_ROW(states, row);
+
+        for(col = ZERO; col < frames -> width; col += WORD_BITS)
+        {/* The dead edge and padding are zero, so bits past the width need no mask */
+            uint64_t bits = cellsAt(cells, states -> words, col + ONE);
+            int count = frames -> width - col, i;
+
+            if(count > WORD_BITS) { count = WORD_BITS; }
+
+            if(frames -> format == EXPORT_RAW1 || frames -> format == EXPORT_PBM)
+            {/* Live cells are white: 1 in monob, 0 in PBM */
+                bits = msbFirst(bits);
+                if(frames -> format == EXPORT_PBM) { bits = ~bits; }
+                for(i = ZERO; i < count; i += 8) { *out++ = (unsigned char) (bits >> i); }
+            }
+            else if(frames -> format == EXPORT_RAW8)
+            {
+                for(i = ZERO; i < count; i += 8) { memcpy(out + i, expandByte[(bits >> i) & 0xff], 8); }
+                out += count;
+            }
+            else
+            {
+                for(i = ZERO; i < count; i++)
+                {
+                    unsigned char value = ((bits >> i) & ONE) ? 255 : ZERO;
+
+                    *out++ = value; *out++ = value; *out++ = value;
+                }
+            }
+        }
+    }
+
+    while(written < frames -> bytes)
+    {/* One write() per frame unless the pipe is full */
+        ssize_t done = write(frames -> fd, frames -> buffer + written, frames -> bytes - written);
+
+        if(done <= ZERO) { return ZERO; }
+        written += (size_t) done;
+    }
+
+return ONE;
+}
+
+void closeExport(FrameExport *frames)
+{
+    if(frames -> fd >= ZERO) { close(frames -> fd); }
+    free(frames -> buffer);
+    frames -> fd = -ONE;
+    frames -> buffer = NULL;
+
+return;
+}
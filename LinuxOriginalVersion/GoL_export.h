@@ -0,0 +1,36 @@
+#ifndef GOL_EXPORT_H
+#define GOL_EXPORT_H
+
+#include "GoL_board.h"
+#include "GoL_heat.h"
+
+enum exportFormat
+{
+    EXPORT_RAW1 = 0, /* 1 bit per cell, MSB first (ffmpeg -pix_fmt monob) */
+    EXPORT_RAW8,     /* 1 byte per cell, 0 or 255 (ffmpeg -pix_fmt gray) */
+    EXPORT_PBM,      /* P4 images, one after the other */
+    EXPORT_PPM,      /* P6 images, one after the other */
+    EXPORT_PGM       /* P5 images of the heatmap instead of the cells (heat must be set) */
+};
+
+struct frameExport
+{
+    int fd;
+    int format;
+    int every;     /* Only every Nth generation is written */
+    int width;     /* The board without its dead edge */
+    int height;
+    size_t header; /* Bytes of image header in front of each frame */
+    size_t bytes;  /* Whole frame, header included */
+    unsigned char *buffer;
+    const HeatMap *heat; /* EXPORT_PGM only, set after openExport() */
+    int heatKind;
+};
+typedef struct frameExport FrameExport;
+
+int exportFormatFromName(const char *name); /* -1 if unknown */
+int openExport(FrameExport *frames, const char *path, int format, int every, Gs *states); /* RETURN 1 => OK! */
+int exportGs(FrameExport *frames, Gs *states, long generation); /* RETURN 0 => write failed */
+void closeExport(FrameExport *frames);
+
+#endif /* GOL_EXPORT_H */
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "GoL_file.h"
+
+static void putUint32(unsigned char *out, uint32_t value)
+{
+    out[0] = (unsigned char) value;
+    out[1] = (unsigned char) (value >> 8);
+    out[2] = (unsigned char) (value >> 16);
+    out[3] = (unsigned char) (value >> 24);
+
+return;
+}
+
+static uint32_t getUint32(const unsigned char *in)
+{
+return (uint32_t) in[0] | ((uint32_t) in[1] << 8) | ((uint32_t) in[2] << 16) | ((uint32_t) in[3] << 24);
+}
+
+int saveGs(Gs *states, const char *path) /* RETURN 1 => OK! */
+{
+    size_t rowBytes = (size_t) states -> words * 8, size = GAMESTATE_HEADER + (rowBytes * (size_t) states -> rows), byte;
+    unsigned char *data = malloc(size), *out;
+    FILE *file;
+    int row, written;
+
+    if(data == NULL) { return ZERO; }
+
+    memcpy(data, GAMESTATE_MAGIC, FOUR);
+    putUint32(data + 4, (uint32_t) states -> rows);
+    putUint32(data + 8, (uint32_t) states -> cols);
+    putUint32(data + 12, (uint32_t) rowBytes);
+    out = data + GAMESTATE_HEADER;
+    for(row = ZERO; row < states -> rows; row++)
+    {/* Byte by byte, so the file is the same on any endianness */
+        const uint64_t *cells = GS_ROW(states, row);
+
+        for(byte = ZERO; byte < rowBytes; byte++) { *out++ = (unsigned char) (cells[byte / 8] >> ((byte % 8) * 8)); }
+    }
+
+    if((file = fopen(path, "wb")) == NULL)
+    {
+        free(data);
+
+    return ZERO;
+    }
+    written = (fwrite(data, ONE, size, file) == size);
+    written = (fclose(file) == ZERO) && written;
+    free(data);
+
+return written;
+}
+
+int loadGs(Gs *states, const char *path) /* RETURN 1 => OK! Cells outside the board are dropped */
+{
+    unsigned char header[GAMESTATE_HEADER], *in;
+    size_t rowBytes, copyBytes, byte;
+    int rows, cols, row, whole = ONE;
+    FILE *file;
+
+    if((file = fopen(path, "rb")) == NULL) { return ZERO; }
+    if(fread(header, ONE, GAMESTATE_HEADER, file) != GAMESTATE_HEADER || memcmp(header, GAMESTATE_MAGIC, FOUR) != ZERO)
+    {
+        fclose(file);
+
+    return ZERO;
+    }
+    rows = (int) getUint32(header + 4);
+    cols = (int) getUint32(header + 8);
+    rowBytes = getUint32(header + 12);
+    if(rowBytes < ((size_t) cols + 7) / 8 || (in = malloc(rowBytes)) == NULL)
+    {
+        fclose(file);
+
+    return ZERO;
+    }
+
+    clearGs(states);
+    copyBytes = ((size_t) (cols < states -> cols ? cols : states -> cols) + 7) / 8;
+    for(row = ZERO; row < rows && row < states -> rows; row++)
+    {
+        uint64_t *cells = GS_ROW(states, row);
+
+        if(fread(in, ONE, rowBytes, file) != rowBytes) { whole = ZERO; break; }
+        for(byte = ZERO; byte < copyBytes; byte++) { cells[byte / 8] |= (uint64_t) in[byte] << ((byte % 8) * 8); }
+    }
+    free(in);
+    fclose(file);
+    if(!whole)
+    {/* Truncated file: an empty board rather than half of one */
+        clearGs(states);
+
+    return ZERO;
+    }
+    deadEdge(states); /* Also drops the columns past a smaller board */
+
+return ONE;
+}
@@ -0,0 +1,18 @@
+#ifndef GOL_FILE_H
+#define GOL_FILE_H
+
+#include "GoL_board.h"
+
+/*
+ * Packed gamestate file, also read and written by GoL-GUI_gamestate_input.py:
+ * "GoLB", rows, cols, rowBytes (little endian uint32), then rows * rowBytes bytes.
+ * Bit (col % 8) of byte (col / 8) of a row is the cell at col, dead edge included.
+ * saveGs() pads rows to whole 64-bit words, so its files can be stepped in place (GoL_mapped.h).
+ */
+#define GAMESTATE_MAGIC "GoLB"
+#define GAMESTATE_HEADER 16
+
+int saveGs(Gs *states, const char *path); /* RETURN 1 => OK! */
+int loadGs(Gs *states, const char *path); /* RETURN 1 => OK! Cells outside the board are dropped */
+
+#endif /* GOL_FILE_H */
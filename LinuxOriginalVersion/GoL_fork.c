@@ -0,0 +1,468 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_fork.h"
+
+#define INTERN_BUCKETS 1024 /* First size of the table of tiles by cells, doubled at one tile per bucket */
+
+static Tile deadTile; /* Every empty tile of every branch, never counted or freed */
+static uint64_t lastSerial = ZERO;
+static long tileCount = ZERO;
+static Tile **internTable = NULL;
+static size_t internSize = ZERO, internCount = ZERO;
+
+static Tile *makeTile(void)
+{
+    Tile *tile = malloc(sizeof(Tile));
+
+    if(tile == NULL) { return NULL; }
+    tile -> refs = ZERO;
+    tile -> owners = ZERO;
+    tile -> serial = ++lastSerial;
+    tile -> steps = NULL;
+    tile -> interned = ZERO;
+    tile -> chain = NULL;
+    tileCount++;
+
+return tile;
+}
+
+static uint64_t hashCells(const uint64_t *cells)
+{
+    uint64_t hash = 0x2545f4914f6cdd1dULL;
+    int row;
+
+    for(row = ZERO; row < TILE_ROWS; row++)
+    {
+        hash = (hash ^ cells[row]) * 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 32;
+    }
+
+return hash;
+}
+
+static Tile *findTile(const uint64_t *cells, uint64_t hash)
+{
+    Tile *tile;
+
+    if(internSize == ZERO) { return NULL; }
+    for(tile = internTable[hash & (internSize - ONE)]; tile != NULL; tile = tile -> chain)
+    {
+        if(tile -> hash == hash && memcmp(tile -> cells, cells, sizeof(tile -> cells)) == ZERO) { return tile; }
+    }
+
+return NULL;
+}
+
+static void internTile(Tile *tile, uint64_t hash)
+{/* A table that cannot grow only gets longer buckets, without one the tile just stays private */
+    Tile **bucket;
+
+    if(internCount >= internSize)
+    {
+        size_t size = internSize ? internSize * TWO : INTERN_BUCKETS, i;
+        Tile **table = calloc(size, sizeof(Tile *)), *move;
+
+        if(table == NULL && internSize == ZERO) { return; }
+        for(i = ZERO; table != NULL && i < internSize; i++)
+        {
+            while((move = internTable[i]) != NULL)
+            {
+                internTable[i] = move -> chain;
+                move -> chain = table[move -> hash & (size - ONE)];
+                table[move -> hash & (size - ONE)] = move;
+            }
+        }
+        if(table != NULL)
+        {
+            free(internTable);
+            internTable = table;
+            internSize = size;
+        }
+    }
+    bucket = internTable + (hash & (internSize - ONE));
+    tile -> hash = hash;
+    tile -> interned = ONE;
+    tile -> chain = *bucket;
+    *bucket = tile;
+    internCount++;
+
+return;
+}
+
+static void uninternTile(Tile *tile)
+{
+    Tile **link;
+
+    if(!tile -> interned) { return; }
+    for(link = internTable + (tile -> hash & (internSize - ONE)); *link != tile; link = &(*link) -> chain) { }
+    *link = tile -> chain;
+    tile -> interned = ZERO;
+    if(--internCount == ZERO)
+    {
+        free(internTable);
+        internTable = NULL;
+        internSize = ZERO;
+    }
+
+return;
+}
+
+static Tile *cellsTile(const uint64_t *cells)
+{/* The tile with these cells, a new one if none is interned, NULL => out of memory */
+    uint64_t hash = hashCells(cells);
+    Tile *tile = findTile(cells, hash);
+
+    if(tile != NULL) { return tile; }
+    if((tile = makeTile()) == NULL) { return NULL; }
+    memcpy(tile -> cells, cells, sizeof(tile -> cells));
+    internTile(tile, hash);
+
+return tile;
+}
+
+static void unrefTile(Tile *tile)
+{
+    if(tile == &deadTile) { return; }
+    if(--tile -> refs == ZERO)
+    {/* No owners left either, so its results are already gone */
+        uninternTile(tile);
+        free(tile);
+        tileCount--;
+    }
+
+return;
+}
+
+static void dropResults(Tile *tile)
+{
+    struct tileStep *step;
+
+    while((step = tile -> steps) != NULL)
+    {
+        tile -> steps = step -> more;
+        if(step -> next != tile) { unrefTile(step -> next); }
+        free(step);
+    }
+
+return;
+}
+
+static void ownTile(Tile *tile)
+{
+    if(tile == &deadTile) { return; }
+    tile -> refs++;
+    tile -> owners++;
+
+return;
+}
+
+static void disownTile(Tile *tile)
+{
+    if(tile == &deadTile) { return; }
+    if(--tile -> owners == ZERO) { dropResults(tile); }
+    unrefTile(tile);
+
+return;
+}
+
+static Tile *tileAt(const Branch *branch, int tileRow, int tileCol)
+{/* Past the board is all dead */
+    if(tileRow < ZERO || tileCol < ZERO || tileRow >= branch -> tilesHigh || tileCol >= branch -> tilesWide) { return &deadTile; }
+
+return branch -> tiles[((size_t) tileRow * (size_t) branch -> tilesWide) + (size_t) tileCol];
+}
+
+static unsigned ruleKey(const BranchRule *rule)
+{
+return rule -> birth | (rule -> survive << 9);
+}
+
+int parseBranchRule(BranchRule *rule, const char *text) /* "B3/S23", RETURN 1 => OK! (no B0) */
+{
+    unsigned *into = NULL;
+
+    rule -> birth = rule -> survive = ZERO;
+    for(; *text != '\0'; text++)
+    {
+        if(*text == 'B' || *text == 'b') { into = &rule -> birth; }
+        else if(*text == 'S' || *text == 's') { into = &rule -> survive; }
+        else if(*text >= '0' && *text <= '8' && into != NULL) { *into |= 1U << (*text - '0'); }
+        else if(*text != '/') { return ZERO; }
+    }
+
+return (rule -> birth & ONE) == ZERO; /* B0 would light up the dead tiles */
+}
+
+int newBranch(Branch *branch, Gs *states, const BranchRule *rule) /* RETURN 1 => OK! */
+{
+    size_t tile, tiles;
+    int tileRow, tileCol, row;
+
+    branch -> rows = states -> rows;
+    branch -> cols = states -> cols;
+    branch -> tilesHigh = (states -> rows + TILE_ROWS - ONE) / TILE_ROWS;
+    branch -> tilesWide = states -> words;
+    branch -> rule = *rule;
+    branch -> generation = ZERO;
+    tiles = (size_t) branch -> tilesHigh * (size_t) branch -> tilesWide;
+    if((branch -> tiles = malloc(tiles * sizeof(Tile *))) == NULL) { return ZERO; }
+    for(tile = ZERO; tile < tiles; tile++) { branch -> tiles[tile] = &deadTile; }
+
+    for(tileRow = ZERO; tileRow < branch -> tilesHigh; tileRow++)
+    {
+        for(tileCol = ZERO; tileCol < branch -> tilesWide; tileCol++)
+        {
+            Tile **slot = branch -> tiles + ((size_t) tileRow * (size_t) branch -> tilesWide) + tileCol;
+            uint64_t cells[TILE_ROWS], any = ZERO;
+
+            for(row = ZERO; row < TILE_ROWS; row++)
+            {
+                cells[row] = ((tileRow * TILE_ROWS) + row < states -> rows) ? GS_ROW(states, (tileRow * TILE_ROWS) + row)[tileCol] : ZERO;
+                any |= cells[row];
+            }
+            if(any == ZERO) { continue; }
+            if((*slot = cellsTile(cells)) == NULL)
+            {
+                *slot = &deadTile;
+                freeBranch(branch);
+
+            return ZERO;
+            }
+            ownTile(*slot);
+        }
+    }
+
+return ONE;
+}
+
+int forkBranch(Branch *to, const Branch *from) /* Same board, generation & rule, RETURN 1 => OK! */
+{
+    size_t tile, tiles = (size_t) from -> tilesHigh * (size_t) from -> tilesWide;
+
+    *to = *from;
+    if((to -> tiles = malloc(tiles * sizeof(Tile *))) == NULL) { return ZERO; }
+    for(tile = ZERO; tile < tiles; tile++)
+    {
+        to -> tiles[tile] = from -> tiles[tile];
+        ownTile(to -> tiles[tile]);
+    }
+
+return ONE;
+}
+
+int getBranchCell(const Branch *branch, int row, int col)
+{
+return (int) ((tileAt(branch, row / TILE_ROWS, col / WORD_BITS) -> cells[row % TILE_ROWS] >> (col % WORD_BITS)) & ONE);
+}
+
+int setBranchCell(Branch *branch, int row, int col, int alive) /* RETURN 0 => out of memory, unchanged */
+{
+    Tile **slot, *tile;
+
+    if(row < ONE || col < ONE || row >= branch -> rows - ONE || col >= branch -> cols - ONE) { return ONE; } /* The dead edge stays dead */
+    if(getBranchCell(branch, row, col) == alive) { return ONE; }
+
+    slot = branch -> tiles + ((size_t) (row / TILE_ROWS) * (size_t) branch -> tilesWide) + (size_t) (col / WORD_BITS);
+    tile = *slot;
+    if(tile == &deadTile || tile -> refs > ONE)
+    {/* Shared: this branch gets its own copy now */
+        Tile *copy = makeTile();
+
+        if(copy == NULL) { return ZERO; }
+        memcpy(copy -> cells, tile -> cells, sizeof(copy -> cells));
+        ownTile(copy);
+        disownTile(tile);
+        *slot = tile = copy;
+    }
+    else
+    {/* Only ours: changed in place, but it is not the tile results were remembered for (or interned by) any more */
+        dropResults(tile);
+        uninternTile(tile);
+        tile -> serial = ++lastSerial;
+    }
+    tile -> cells[row % TILE_ROWS] ^= 1ULL << (col % WORD_BITS);
+
+return ONE;
+}
+
+static uint64_t applyRule(const BranchRule *rule, uint64_t mid, uint64_t ones, uint64_t twos, uint64_t fours, uint64_t eights)
+{/* Neighbour count n = ones + 2 * twos + 4 * fours + 8 * eights per bit */
+    uint64_t born = ZERO, stays = ZERO, equal;
+    int count;
+
+    for(count = ZERO; count <= 8; count++)
+    {
+        if((((rule -> birth | rule -> survive) >> count) & ONE) == ZERO) { continue; }
+        equal = ((count & ONE) ? ones : ~ones) & ((count & TWO) ? twos : ~twos) & ((count & FOUR) ? fours : ~fours) & ((count & 8) ? eights : ~eights);
+        if((rule -> birth >> count) & ONE) { born |= equal; }
+        if((rule -> survive >> count) & ONE) { stays |= equal; }
+    }
+
+return (~mid & born) | (mid & stays);
+}
+
+static void stepTile(const Branch *branch, Tile *around[9], int tileRow, int tileCol, uint64_t *out)
+{/* around: NW N NE / W self E / SW S SE, the tile gets one row from above and below */
+    uint64_t west[TILE_ROWS + TWO], self[TILE_ROWS + TWO], east[TILE_ROWS + TWO], lastMask;
+    int row, col;
+
+    for(col = ZERO; col < THREE; col++)
+    {
+        uint64_t *into = (col == ZERO) ? west : ((col == ONE) ? self : east);
+
+        into[ZERO] = around[col] -> cells[TILE_ROWS - ONE];
+        memcpy(into + ONE, around[THREE + col] -> cells, sizeof(around[THREE + col] -> cells));
+        into[TILE_ROWS + ONE] = around[6 + col] -> cells[ZERO];
+    }
+
+    for(row = ONE; row <= TILE_ROWS; row++)
+    {/* The same adders as processRow(), carried on to exact counts */
+        uint64_t upW = (self[row - ONE] << ONE) | (west[row - ONE] >> 63), upE = (self[row - ONE] >> ONE) | (east[row - ONE] << 63);
+        uint64_t midW = (self[row] << ONE) | (west[row] >> 63), midE = (self[row] >> ONE) | (east[row] << 63);
+        uint64_t downW = (self[row + ONE] << ONE) | (west[row + ONE] >> 63), downE = (self[row + ONE] >> ONE) | (east[row + ONE] << 63);
+        uint64_t up = self[row - ONE], down = self[row + ONE];
+        uint64_t sumUp, carryUp, sumDown, carryDown, sumMid, carryMid, ones, carryOnes, twosLow, twosHigh;
+
+        sumUp = upW ^ up ^ upE; carryUp = (upW & up) | (upE & (upW ^ up));
+        sumDown = downW ^ down ^ downE; carryDown = (downW & down) | (downE & (downW ^ down));
+        sumMid = midW ^ midE; carryMid = midW & midE;
+
+        ones = sumUp ^ sumDown ^ sumMid; carryOnes = (sumUp & sumDown) | (sumMid & (sumUp ^ sumDown));
+        twosLow = carryUp ^ carryDown ^ carryMid; twosHigh = (carryUp & carryDown) | (carryMid & (carryUp ^ carryDown));
+
+        out[row - ONE] = applyRule(&branch -> rule, self[row], ones, twosLow ^ carryOnes, twosHigh ^ (twosLow & carryOnes), twosHigh & twosLow & carryOnes);
+    }
+
+    /* Dead edge: rows 0 and rows - 1 and past them, first & last column and the padding past it */
+    lastMask = (branch -> cols % WORD_BITS) ? (1ULL << (branch -> cols % WORD_BITS)) - ONE : ~0ULL;
+    for(row = ZERO; row < TILE_ROWS; row++)
+    {
+        int boardRow = (tileRow * TILE_ROWS) + row;
+
+        if(boardRow == ZERO || boardRow >= branch -> rows - ONE) { out[row] = ZERO; }
+        if(tileCol == ZERO) { out[row] &= ~1ULL; }
+        if(tileCol == branch -> tilesWide - ONE) { out[row] &= lastMask & ~(1ULL << ((branch -> cols - ONE) % WORD_BITS)); }
+    }
+
+return;
+}
+
+int stepBranch(Branch *branch) /* One generation, RETURN 0 => out of memory, unchanged */
+{
+    size_t tiles = (size_t) branch -> tilesHigh * (size_t) branch -> tilesWide, done = ZERO;
+    Tile **fresh = malloc(tiles * sizeof(Tile *));
+    unsigned key = ruleKey(&branch -> rule);
+    int tileRow, tileCol, i;
+
+    if(fresh == NULL) { return ZERO; }
+    for(tileRow = ZERO; tileRow < branch -> tilesHigh; tileRow++)
+    {
+        for(tileCol = ZERO; tileCol < branch -> tilesWide; tileCol++, done++)
+        {
+            Tile *around[9], *tile, *result;
+            struct tileStep *step = NULL;
+            uint64_t cells[TILE_ROWS], any = ZERO;
+            int quiet = ONE, remembered;
+
+            for(i = ZERO; i < 9; i++)
+            {
+                around[i] = tileAt(branch, tileRow + (i / THREE) - ONE, tileCol + (i % THREE) - ONE);
+                quiet = quiet && (around[i] == &deadTile);
+            }
+            tile = around[FOUR];
+            if(quiet) { fresh[done] = &deadTile; continue; }
+
+            if(tile != &deadTile) { for(step = tile -> steps; step != NULL && step -> ruleKey != key; step = step -> more) { } }
+            remembered = (step != NULL);
+            for(i = ZERO; remembered && i < 9; i++) { remembered = (i == FOUR) || step -> around[i - (i > FOUR)] == around[i] -> serial; }
+            if(remembered)
+            {/* Another branch (or this one, for a still tile) already took this tile here */
+                fresh[done] = step -> next;
+                ownTile(fresh[done]);
+                continue;
+            }
+
+            stepTile(branch, around, tileRow, tileCol, cells);
+            for(i = ZERO; i < TILE_ROWS; i++) { any |= cells[i]; }
+            if(any == ZERO) { result = &deadTile; }
+            else if(tile != &deadTile && memcmp(cells, tile -> cells, sizeof(cells)) == ZERO) { result = tile; }
+            else if((result = cellsTile(cells)) == NULL)
+            {/* Same cells as a tile of any branch => that tile */
+                while(done > ZERO) { disownTile(fresh[--done]); }
+                free(fresh);
+
+            return ZERO;
+            }
+            ownTile(result);
+
+            if(step == NULL && tile != &deadTile && (step = malloc(sizeof(struct tileStep))) != NULL)
+            {/* First time under this rule (no memory for it => just not remembered) */
+                step -> next = tile;
+                step -> more = tile -> steps;
+                tile -> steps = step;
+            }
+            if(step != NULL)
+            {/* Remember it, the result is kept alive by it (not when the result is the tile itself) */
+                if(step -> next != tile) { unrefTile(step -> next); }
+                step -> next = result;
+                if(result != tile && result != &deadTile) { result -> refs++; }
+                for(i = ZERO; i < 9; i++) { if(i != FOUR) { step -> around[i - (i > FOUR)] = around[i] -> serial; } }
+                step -> ruleKey = key;
+            }
+            fresh[done] = result;
+        }
+    }
+
+    /* Flow of Time */
+    for(done = ZERO; done < tiles; done++) { disownTile(branch -> tiles[done]); }
+    free(branch -> tiles);
+    branch -> tiles = fresh;
+    branch -> generation++;
+
+return ONE;
+}
+
+long branchPopulation(const Branch *branch)
+{
+    size_t tile, tiles = (size_t) branch -> tilesHigh * (size_t) branch -> tilesWide;
+    long liveCount = ZERO;
+    int row;
+
+    for(tile = ZERO; tile < tiles; tile++)
+    {
+        if(branch -> tiles[tile] == &deadTile) { continue; }
+        for(row = ZERO; row < TILE_ROWS; row++) { liveCount += __builtin_popcountll(branch -> tiles[tile] -> cells[row]); }
+    }
+
+return liveCount;
+}
+
+void branchToGs(const Branch *branch, Gs *states) /* states must be the branch's size */
+{
+    int row, word;
+
+    for(row = ZERO; row < states -> rows; row++)
+    {
+        for(word = ZERO; word < states -> words; word++) { GS_ROW(states, row)[word] = tileAt(branch, row / TILE_ROWS, word) -> cells[row % TILE_ROWS]; }
+    }
+
+return;
+}
+
+void freeBranch(Branch *branch)
+{
+    size_t tile, tiles = (size_t) branch -> tilesHigh * (size_t) branch -> tilesWide;
+
+    if(branch -> tiles == NULL) { return; }
+    for(tile = ZERO; tile < tiles; tile++) { disownTile(branch -> tiles[tile]); }
+    free(branch -> tiles);
+    branch -> tiles = NULL;
+
+return;
+}
+
+long tilesInUse(void) /* All branches together, the dead tile not counted */
+{
+return tileCount;
+}
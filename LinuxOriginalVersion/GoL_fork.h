@@ -0,0 +1,72 @@
+#ifndef GOL_FORK_H
+#define GOL_FORK_H
+
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Copy-on-write branches of a board, for what-if runs: the board is cut into 64 x 64 cell
+ * tiles (64 rows of one word) shared by reference count. forkBranch() copies only the tile
+ * table, setBranchCell() copies a tile the first time a shared one is written, and all empty
+ * tiles are one shared dead tile. Stepping keeps sharing too: a tile remembers what it became
+ * next to which neighbours under each rule, so branches that did not diverge around it reuse
+ * that tile instead of computing their own, and a computed tile is looked up by its cells
+ * (interned), so branches that diverged elsewhere still end up with one tile where they agree.
+ * Not thread safe: the reference counts are plain integers.
+ */
+
+#define TILE_ROWS 64
+
+struct branchRule
+{/* Bit n set => n live neighbours give birth / keep a live cell, Conway is B3/S23 */
+    unsigned birth;
+    unsigned survive;
+};
+typedef struct branchRule BranchRule;
+
+struct tileStep
+{/* What a tile became the last time it was stepped under one rule */
+    struct tile *next;   /* Holds a reference unless it is the tile itself */
+    uint64_t around[8];  /* Serials of the neighbours it was stepped with */
+    unsigned ruleKey;    /* birth | survive << 9 */
+    struct tileStep *more;
+};
+
+struct tile
+{
+    long refs;           /* Branch tables and results of other tiles */
+    long owners;         /* Branch tables only, at 0 its results are let go (no chains of old generations) */
+    uint64_t serial;     /* Never reused, 0 => the dead tile */
+    struct tileStep *steps; /* One per rule it was stepped under, NULL => none */
+    uint64_t hash;       /* Of cells, while interned */
+    int interned;        /* In the table of tiles by cells, 0 => a private copy being edited */
+    struct tile *chain;  /* Next in the same bucket of that table */
+    uint64_t cells[TILE_ROWS];
+};
+typedef struct tile Tile;
+
+struct branch
+{
+    int rows;            /* Board size, dead edge included */
+    int cols;
+    int tilesHigh;
+    int tilesWide;       /* Same as the words of a packed row */
+    Tile **tiles;        /* tilesHigh * tilesWide, row major */
+    BranchRule rule;
+    long generation;
+};
+typedef struct branch Branch;
+
+int parseBranchRule(BranchRule *rule, const char *text); /* "B3/S23", RETURN 1 => OK! (no B0) */
+int newBranch(Branch *branch, Gs *states, const BranchRule *rule); /* RETURN 1 => OK! */
+int forkBranch(Branch *to, const Branch *from); /* Same board, generation & rule, RETURN 1 => OK! */
+int getBranchCell(const Branch *branch, int row, int col);
+int setBranchCell(Branch *branch, int row, int col, int alive); /* RETURN 0 => out of memory, unchanged */
+int stepBranch(Branch *branch); /* One generation, RETURN 0 => out of memory, unchanged */
+long branchPopulation(const Branch *branch);
+void branchToGs(const Branch *branch, Gs *states); /* states must be the branch's size */
+void freeBranch(Branch *branch);
+long tilesInUse(void); /* All branches together, the dead tile not counted */
+
+#endif /* GOL_FORK_H */
@@ -0,0 +1,119 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_heat.h"
+
+typedef unsigned char Heat16 __attribute__((vector_size(16)));
+typedef uint64_t Heat2 __attribute__((vector_size(16))); /* The same 16 bytes, 8 at a time */
+
+static uint64_t expandBits[256]; /* Bit n of the index => byte n is 0xff */
+static const char *kindNames[] = { "age", "flips" };
+
+int heatKindFromName(const char *name) /* -1 if unknown */
+{
+    int kind;
+
+    for(kind = HEAT_AGE; kind <= HEAT_FLIPS; kind++) { if(strcmp(kindNames[kind], name) == ZERO) { return kind; } }
+
+return -ONE;
+}
+
+int newHeat(HeatMap *heat, Gs *states) /* No flips, every age 255, RETURN 1 => OK! */
+{
+    int byte, bit;
+
+    heat -> rows = states -> rows;
+    heat -> cols = states -> cols;
+    heat -> stride = (size_t) states -> words * WORD_BITS;
+    heat -> age = calloc((size_t) states -> rows * heat -> stride, ONE);
+    heat -> flips = calloc((size_t) states -> rows * heat -> stride, ONE);
+    if(heat -> age == NULL || heat -> flips == NULL)
+    {
+        freeHeat(heat);
+
+    return ZERO;
+    }
+    /* Nothing seen changing yet: start cold (the dead edge stays so) */
+    memset(heat -> age, HEAT_MAX, (size_t) states -> rows * heat -> stride);
+    for(byte = ZERO; byte < 256; byte++)
+    {
+        expandBits[byte] = ZERO;
+        for(bit = ZERO; bit < 8; bit++) { if((byte >> bit) & ONE) { expandBits[byte] |= 0xffULL << (bit * 8); } }
+    }
+
+return ONE;
+}
+
+static void heatRow(HeatMap *heat, int row, const uint64_t *before, const uint64_t *after, int words)
+{/* age = changed ? 0 : age + 1, flips += changed, both stopping at 255 */
+    const Heat16 full = { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 };
+    unsigned char *age = heat -> age + ((size_t) row * heat -> stride), *flips = heat -> flips + ((size_t) row * heat -> stride);
+    int word, cell;
+
+    for(word = ZERO; word < words; word++)
+    {
+        uint64_t changed = before[word] ^ after[word];
+
+        for(cell = ZERO; cell < WORD_BITS; cell += 16, age += 16, flips += 16)
+        {
+            Heat2 spread = { expandBits[(changed >> cell) & 0xff], expandBits[(changed >> (cell + 8)) & 0xff] };
+            Heat16 mask = (Heat16) spread, counts; /* Byte n: 0xff if cell n changed */
+
+            memcpy(&counts, age, 16);
+            counts = (counts - (Heat16) (counts != full)) & ~mask; /* != is -1 where true */
+            memcpy(age, &counts, 16);
+            if(changed == ZERO) { continue; } /* Quiet words leave flips alone */
+            memcpy(&counts, flips, 16);
+            counts -= (Heat16) (counts != full) & mask;
+            memcpy(flips, &counts, 16);
+        }
+    }
+
+return;
+}
+
+void stepHeat(HeatMap *heat, Gs *states) /* One generation of the word engine, counters included */
+{
+    size_t words = (size_t) states -> words;
+    uint64_t *swap;
+    int row;
+
+    for(row = ONE; row < states -> rows - ONE; row++)
+    {
+        uint64_t *before = states -> gameState1 + (row * words), *after = states -> gameState2 + (row * words);
+
+        processRow(before - words, before, before + words, after, states -> words);
+        /* processGs_FoT()'s deadEdge() in advance: edge cells never change, so they never heat up */
+        after[ZERO] &= ~1ULL;
+        after[(states -> cols - ONE) / WORD_BITS] &= ~(1ULL << ((states -> cols - ONE) % WORD_BITS));
+        if(states -> cols % WORD_BITS) { after[words - ONE] &= (1ULL << (states -> cols % WORD_BITS)) - ONE; }
+        heatRow(heat, row, before, after, states -> words);
+        markWords(states, row, before, after);
+    }
+    /* Flow of Time */
+    swap = states -> gameState1;
+    states -> gameState1 = states -> gameState2;
+    states -> gameState2 = swap;
+    deadEdge(states);
+
+return;
+}
+
+void updateHeat(HeatMap *heat, Gs *states) /* After an engine left the last generation in gameState2 */
+{
+    size_t words = (size_t) states -> words;
+    int row;
+
+    for(row = ONE; row < states -> rows - ONE; row++) { heatRow(heat, row, states -> gameState2 + (row * words), states -> gameState1 + (row * words), states -> words); }
+
+return;
+}
+
+void freeHeat(HeatMap *heat)
+{
+    free(heat -> age);
+    free(heat -> flips);
+    heat -> age = heat -> flips = NULL;
+
+return;
+}
@@ -0,0 +1,44 @@
+#ifndef GOL_HEAT_H
+#define GOL_HEAT_H
+
+#include <stddef.h>
+
+#include "GoL_board.h"
+
+/*
+ * Activity heatmap: per cell, generations since it last changed and how often it flipped,
+ * both saturating at 255. stepHeat() is processGs_FoT() with the counters of each row
+ * updated right after the row is computed (old and new row still in cache), 16 cells
+ * per vector operation. Other engines step first, leaving the last generation in
+ * gameState2, and call updateHeat().
+ */
+
+#define HEAT_MAX 255
+
+enum heatKind
+{
+    HEAT_AGE = 0, /* Generations since the cell last changed */
+    HEAT_FLIPS    /* Times it changed */
+};
+
+struct heatMap
+{
+    int rows;
+    int cols;
+    size_t stride;        /* Bytes per row: whole words of cells, so rows need no tail */
+    unsigned char *age;   /* rows * stride */
+    unsigned char *flips;
+};
+typedef struct heatMap HeatMap;
+
+/* 0 (cold) .. 255 (hot): the flips, or how recently the cell changed */
+#define HEAT_AT(heat, kind, row, col) (((kind) == HEAT_FLIPS) ? (heat) -> flips[((size_t) (row) * (heat) -> stride) + (size_t) (col)] \
+                                                              : HEAT_MAX - (heat) -> age[((size_t) (row) * (heat) -> stride) + (size_t) (col)])
+
+int heatKindFromName(const char *name); /* -1 if unknown */
+int newHeat(HeatMap *heat, Gs *states); /* No flips, every age 255, RETURN 1 => OK! */
+void stepHeat(HeatMap *heat, Gs *states); /* One generation of the word engine, counters included */
+void updateHeat(HeatMap *heat, Gs *states); /* After an engine left the last generation in gameState2 */
+void freeHeat(HeatMap *heat);
+
+#endif /* GOL_HEAT_H */
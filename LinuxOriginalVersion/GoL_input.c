@@ -0,0 +1,63 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "GoL_board.h"
+#include "GoL_input.h"
+
+static struct termios original;
+static int isRaw = ZERO;
+
+int rawTerminal(int enable) /* RETURN 1 => OK! (stdin is a terminal) */
+{
+    struct termios raw;
+
+    if(enable && !isRaw)
+    {
+        if(!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &original) != ZERO) { return ZERO; }
+
+        raw = original;
+        /* Key by key, no echo, Ctrl-C arrives as a key so the terminal is always restored */
+        raw.c_lflag &= ~(ICANON | ECHO | ISIG);
+        raw.c_cc[VMIN] = ONE;
+        raw.c_cc[VTIME] = ZERO;
+        if(tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != ZERO) { return ZERO; }
+
+        printf("%s", "\033[?25l"); /* Hide cursor */
+        fflush(stdout);
+        isRaw = ONE;
+    }
+    else if(!enable && isRaw)
+    {
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &original);
+        printf("%s", "\033[?25h"); /* Show cursor */
+        fflush(stdout);
+        isRaw = ZERO;
+    }
+
+return ONE;
+}
+
+int readKeys(int keys[MAX_KEYS]) /* Keys waiting on stdin, -1 => EOF */
+{
+    unsigned char input[MAX_KEYS];
+    ssize_t length = read(STDIN_FILENO, input, sizeof(input));
+    int i = ZERO, count = ZERO;
+
+    if(length <= ZERO) { return -ONE; }
+
+    while(i < length && count < MAX_KEYS)
+    {/* Arrows come as ESC [ A..D, a lone ESC is the key itself */
+        if(input[i] == KEY_ESC && (i + TWO) < length && input[i + ONE] == '[' && input[i + TWO] >= 'A' && input[i + TWO] <= 'D')
+        {
+            keys[count++] = KEY_UP + (input[i + TWO] - 'A');
+            i += THREE;
+        }
+        else { keys[count++] = input[i++]; }
+    }
+
+return count;
+}
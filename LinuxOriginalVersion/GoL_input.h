@@ -0,0 +1,18 @@
+#ifndef GOL_INPUT_H
+#define GOL_INPUT_H
+
+#define MAX_KEYS 32
+
+enum specialKeys
+{
+    KEY_ESC = 27,
+    KEY_UP = 256, /* Past any single byte */
+    KEY_DOWN,
+    KEY_RIGHT,
+    KEY_LEFT
+};
+
+int rawTerminal(int enable); /* RETURN 1 => OK! (stdin is a terminal) */
+int readKeys(int keys[MAX_KEYS]); /* Keys waiting on stdin, -1 => EOF */
+
+#endif /* GOL_INPUT_H */
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "GoL_ltl.h"
+
+int parseLtl(LtlRule *rule, const char *text) /* RETURN 1 => OK! */
+{
+    int states, used = ZERO, most;
+
+    if(sscanf(text, "R%d,C%d,M%d,S%d..%d,B%d..%d%n", &rule -> radius, &states, &rule -> middle,
+              &rule -> surviveMin, &rule -> surviveMax, &rule -> birthMin, &rule -> birthMax, &used) != 7) { return ZERO; }
+    /* Only 2 states (C0 and C2 both mean that) and the square (Moore) neighbourhood */
+    if(strcmp(text + used, "") != ZERO && strcmp(text + used, ",NM") != ZERO) { return ZERO; }
+    if((states != ZERO && states != TWO) || rule -> radius < ONE || rule -> radius > MAX_LTL_RADIUS || (rule -> middle != ZERO && rule -> middle != ONE)) { return ZERO; }
+
+    most = ((TWO * rule -> radius) + ONE) * ((TWO * rule -> radius) + ONE);
+    if(rule -> surviveMin < ZERO || rule -> surviveMax > most || rule -> birthMin < ZERO || rule -> birthMax > most) { return ZERO; }
+
+return ONE;
+}
+
+int newLtl(Ltl *ltl, Gs *states, const LtlRule *rule) /* RETURN 1 => OK! */
+{
+    ltl -> rule = *rule;
+    ltl -> rows = states -> rows;
+    ltl -> cols = states -> cols;
+    ltl -> sums = malloc((size_t) (states -> rows + ONE) * (size_t) (states -> cols + ONE) * sizeof(uint32_t));
+
+return ltl -> sums != NULL;
+}
+
+void stepLtl(Ltl *ltl, Gs *states)
+{
+    size_t stride = (size_t) ltl -> cols + ONE;
+    uint32_t *sums = ltl -> sums;
+    uint64_t *swap;
+    int row, col, radius = ltl -> rule.radius;
+
+    /* Summed-area table of this generation: row prefix sums stacked on the line above */
+    memset(sums, ZERO, stride * sizeof(uint32_t));
+    for(row = ZERO; row < ltl -> rows; row++)
+    {
+        const uint64_t *cells = GS_ROW(states, row);
+        uint32_t *above = sums + ((size_t) row * stride), *line = above + stride, running = ZERO;
+
+        line[ZERO] = ZERO;
+        for(col = ZERO; col < ltl -> cols; col++)
+        {
+            running += (uint32_t) ((cells[col / WORD_BITS] >> (col % WORD_BITS)) & ONE);
+            line[col + ONE] = above[col + ONE] + running;
+        }
+    }
+
+    /* Each window is 4 lookups, clipped to the board: everything outside it is dead */
+    memset(states -> gameState2, DEAD, gsWords(states -> rows, states -> cols) * sizeof(uint64_t));
+    for(row = ONE; row < ltl -> rows - ONE; row++)
+    {
+        int top = (row - radius < ZERO) ? ZERO : row - radius;
+        int bottom = (row + radius + ONE > ltl -> rows) ? ltl -> rows : row + radius + ONE;
+        const uint32_t *upper = sums + ((size_t) top * stride), *lower = sums + ((size_t) bottom * stride);
+        const uint64_t *cells = GS_ROW(states, row);
+        uint64_t *out = states -> gameState2 + ((size_t) row * (size_t) states -> words);
+
+        for(col = ONE; col < ltl -> cols - ONE; col++)
+        {
+            int left = (col - radius < ZERO) ? ZERO : col - radius;
+            int right = (col + radius + ONE > ltl -> cols) ? ltl -> cols : col + radius + ONE;
+            int live = (int) ((cells[col / WORD_BITS] >> (col % WORD_BITS)) & ONE);
+            int sum = (int) (lower[right] - lower[left] - upper[right] + upper[left]);
+
+            if(!ltl -> rule.middle) { sum -= live; }
+            if(live ? (sum >= ltl -> rule.surviveMin && sum <= ltl -> rule.surviveMax)
+                    : (sum >= ltl -> rule.birthMin && sum <= ltl -> rule.birthMax)) { out[col / WORD_BITS] |= 1ULL << (col % WORD_BITS); }
+        }
+        markWords(states, row, cells, out);
+    }
+
+    /* Flow of Time */
+    swap = states -> gameState1;
+    states -> gameState1 = states -> gameState2;
+    states -> gameState2 = swap;
+    deadEdge(states);
+
+return;
+}
+
+void freeLtl(Ltl *ltl)
+{
+    free(ltl -> sums);
+    ltl -> sums = NULL;
+
+return;
+}
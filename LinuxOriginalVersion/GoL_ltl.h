@@ -0,0 +1,41 @@
+#ifndef GOL_LTL_H
+#define GOL_LTL_H
+
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Larger than Life: Moore neighbourhood of radius R, a cell is born / survives when the
+ * live cells in its (2R + 1) x (2R + 1) square fall in a range. The window sums come
+ * from a summed-area table rebuilt every generation, so R = 20 costs what R = 1 costs.
+ */
+
+#define MAX_LTL_RADIUS 500
+
+struct ltlRule
+{/* Golly notation: "R5,C0,M1,S34..58,B34..45" (Conway's Life is "R1,C0,M0,S2..3,B3..3") */
+    int radius;
+    int middle;     /* 1 => the cell itself is part of its neighbourhood sum */
+    int surviveMin;
+    int surviveMax;
+    int birthMin;
+    int birthMax;
+};
+typedef struct ltlRule LtlRule;
+
+struct ltlEngine
+{
+    LtlRule rule;
+    int rows;
+    int cols;
+    uint32_t *sums; /* (rows + 1) x (cols + 1), sums[r][c] = live cells above and left of (r, c) */
+};
+typedef struct ltlEngine Ltl;
+
+int parseLtl(LtlRule *rule, const char *text); /* RETURN 1 => OK! */
+int newLtl(Ltl *ltl, Gs *states, const LtlRule *rule); /* RETURN 1 => OK! */
+void stepLtl(Ltl *ltl, Gs *states);
+void freeLtl(Ltl *ltl);
+
+#endif /* GOL_LTL_H */
@@ -0,0 +1,230 @@
+#define _XOPEN_SOURCE 600 /* NEEDED FOR posix_fadvise() & madvise() */
+#define _DEFAULT_SOURCE /* NEEDED FOR MADV_* */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "GoL_file.h"
+#include "GoL_mapped.h"
+
+static void putUint32(unsigned char *out, uint32_t value)
+{
+    out[0] = (unsigned char) value;
+    out[1] = (unsigned char) (value >> 8);
+    out[2] = (unsigned char) (value >> 16);
+    out[3] = (unsigned char) (value >> 24);
+
+return;
+}
+
+static uint32_t getUint32(const unsigned char *in)
+{
+return (uint32_t) in[0] | ((uint32_t) in[1] << 8) | ((uint32_t) in[2] << 16) | ((uint32_t) in[3] << 24);
+}
+
+static int makeFile(const char *path, const unsigned char *header, size_t size) /* RETURN fd, -1 => failed */
+{/* ftruncate() leaves a sparse file: every cell dead, no disk used until written */
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if(fd < ZERO) { return -ONE; }
+    if(pwrite(fd, header, GAMESTATE_HEADER, ZERO) != GAMESTATE_HEADER || ftruncate(fd, (off_t) size) != ZERO)
+    {
+        close(fd);
+        unlink(path);
+
+    return -ONE;
+    }
+
+return fd;
+}
+
+static uint64_t *rowIn(MappedGs *board, int which, int row)
+{
+return (uint64_t *) (board -> map[which] + GAMESTATE_HEADER + ((size_t) row * board -> rowBytes));
+}
+
+static void edgeRow(MappedGs *board, int which, int row, uint64_t lastMask) /* lastMask: the last word's cells inside the edge */
+{/* Dead edge of a row about to be read, stamped or loaded cells there included: written only if needed, a clean page stays clean */
+    uint64_t *cells = rowIn(board, which, row);
+    int word;
+
+    if(row == ZERO || row == board -> rows - ONE)
+    {
+        for(word = ZERO; word < board -> words; word++) { if(cells[word]) { cells[word] = ZERO; } }
+
+    return;
+    }
+    if(cells[ZERO] & 1ULL) { cells[ZERO] &= ~1ULL; }
+    if(cells[board -> words - ONE] & ~lastMask) { cells[board -> words - ONE] &= lastMask; }
+
+return;
+}
+
+static void leaveBehind(MappedGs *board, size_t from, size_t to)
+{/* Rows in [from, to) bytes of the file are done with: written ones go to disk, all leave memory */
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    int which;
+
+    from = (from + page - ONE) / page * page;
+    to = to / page * page;
+    if(to <= from) { return; }
+    for(which = ZERO; which < TWO; which++)
+    {
+        if(which != board -> current) { msync(board -> map[which] + from, to - from, MS_ASYNC); }
+        madvise(board -> map[which] + from, to - from, MADV_DONTNEED);
+        posix_fadvise(board -> fd[which], (off_t) from, (off_t) (to - from), POSIX_FADV_DONTNEED);
+    }
+
+return;
+}
+
+int createMapped(const char *path, int rows, int cols) /* Empty board file, RETURN 1 => OK! */
+{
+    unsigned char header[GAMESTATE_HEADER];
+    size_t rowBytes = (size_t) WORDS_FOR(cols) * 8;
+    int fd;
+
+    memcpy(header, GAMESTATE_MAGIC, FOUR);
+    putUint32(header + 4, (uint32_t) rows);
+    putUint32(header + 8, (uint32_t) cols);
+    putUint32(header + 12, (uint32_t) rowBytes);
+    if((fd = makeFile(path, header, GAMESTATE_HEADER + ((size_t) rows * rowBytes))) < ZERO) { return ZERO; }
+
+return close(fd) == ZERO;
+}
+
+int openMapped(MappedGs *board, const char *path) /* RETURN 1 => OK! */
+{
+    unsigned char header[GAMESTATE_HEADER];
+    struct stat info;
+    int which;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+    (void) board; (void) path; (void) header; (void) info; (void) which;
+
+return ZERO; /* The file is little endian bytes, only there are they also uint64_t words */
+#else
+    memset(board, ZERO, sizeof(MappedGs));
+    board -> fd[ZERO] = board -> fd[ONE] = -ONE;
+    if((board -> fd[ZERO] = open(path, O_RDWR)) < ZERO) { return ZERO; }
+    if(pread(board -> fd[ZERO], header, GAMESTATE_HEADER, ZERO) != GAMESTATE_HEADER || memcmp(header, GAMESTATE_MAGIC, FOUR) != ZERO)
+    {
+        closeMapped(board);
+
+    return ZERO;
+    }
+    board -> rows = (int) getUint32(header + 4);
+    board -> cols = (int) getUint32(header + 8);
+    board -> words = WORDS_FOR(board -> cols);
+    board -> rowBytes = getUint32(header + 12);
+    board -> size = GAMESTATE_HEADER + ((size_t) board -> rows * board -> rowBytes);
+    if(board -> rows < THREE || board -> cols < THREE || board -> rowBytes != (size_t) board -> words * 8
+       || fstat(board -> fd[ZERO], &info) != ZERO || (size_t) info.st_size < board -> size)
+    {/* Rows must be whole words: files from saveGs() / createMapped() are */
+        closeMapped(board);
+
+    return ZERO;
+    }
+
+    board -> path[ZERO] = malloc(strlen(path) + ONE);
+    board -> path[ONE] = malloc(strlen(path) + sizeof(".next"));
+    if(board -> path[ZERO] == NULL || board -> path[ONE] == NULL)
+    {
+        closeMapped(board);
+
+    return ZERO;
+    }
+    strcpy(board -> path[ZERO], path);
+    sprintf(board -> path[ONE], "%s%s", path, ".next");
+    if((board -> fd[ONE] = makeFile(board -> path[ONE], header, board -> size)) < ZERO)
+    {
+        closeMapped(board);
+
+    return ZERO;
+    }
+
+    for(which = ZERO; which < TWO; which++)
+    {
+        board -> map[which] = mmap(NULL, board -> size, PROT_READ | PROT_WRITE, MAP_SHARED, board -> fd[which], ZERO);
+        if(board -> map[which] == MAP_FAILED)
+        {
+            board -> map[which] = NULL;
+            closeMapped(board);
+
+        return ZERO;
+        }
+        madvise(board -> map[which], board -> size, MADV_SEQUENTIAL); /* Read ahead, drop behind */
+    }
+
+return ONE;
+#endif
+}
+
+uint64_t *mappedRow(MappedGs *board, int row) /* Present generation */
+{
+return rowIn(board, board -> current, row);
+}
+
+long long stepMapped(MappedGs *board) /* One generation, RETURN its population */
+{/* Three rows in, one row out: the same sliding window as processGs_FoT() */
+    int from = board -> current, to = !board -> current, row, word;
+    uint64_t lastMask = ((board -> cols % WORD_BITS) ? (1ULL << (board -> cols % WORD_BITS)) - ONE : ~0ULL) & ~(1ULL << ((board -> cols - ONE) % WORD_BITS));
+    size_t dropped = ZERO;
+    long long population = ZERO;
+
+    for(row = ONE; row < board -> rows - ONE; row++)
+    {
+        uint64_t *out = rowIn(board, to, row);
+
+        if(row == ONE) { edgeRow(board, from, ZERO, lastMask); edgeRow(board, from, ONE, lastMask); }
+        edgeRow(board, from, row + ONE, lastMask);
+        processRow(rowIn(board, from, row - ONE), rowIn(board, from, row), rowIn(board, from, row + ONE), out, board -> words);
+        /* Dead edge: first & last column, and the padding past it (rows 0 and rows - 1 are never written, only cleared by edgeRow()) */
+        out[ZERO] &= ~1ULL;
+        out[board -> words - ONE] &= lastMask;
+        for(word = ZERO; word < board -> words; word++) { population += __builtin_popcountll(out[word]); }
+
+        if(GAMESTATE_HEADER + ((size_t) (row - ONE) * board -> rowBytes) - dropped >= (size_t) MAPPED_CHUNK)
+        {/* Rows above row - 1 are not read or written again this generation */
+            leaveBehind(board, dropped, GAMESTATE_HEADER + ((size_t) (row - ONE) * board -> rowBytes));
+            dropped = GAMESTATE_HEADER + ((size_t) (row - ONE) * board -> rowBytes);
+        }
+    }
+    leaveBehind(board, dropped, board -> size);
+    /* Flow of Time */
+    board -> current = to;
+
+return population;
+}
+
+int closeMapped(MappedGs *board) /* Leaves the last generation in the board file, RETURN 1 => OK! */
+{
+    int which, done = ONE;
+
+    for(which = ZERO; which < TWO; which++)
+    {
+        if(board -> map[which] != NULL)
+        {
+            if(which == board -> current) { done = (msync(board -> map[which], board -> size, MS_SYNC) == ZERO) && done; }
+            munmap(board -> map[which], board -> size);
+        }
+        if(board -> fd[which] >= ZERO) { close(board -> fd[which]); }
+    }
+    if(board -> map[ZERO] != NULL && board -> map[ONE] != NULL)
+    {/* The newest generation takes the board file's name, the other one goes */
+        if(board -> current == ONE) { done = (rename(board -> path[ONE], board -> path[ZERO]) == ZERO) && done; }
+        else { unlink(board -> path[ONE]); }
+    }
+    else if(board -> fd[ONE] >= ZERO) { unlink(board -> path[ONE]); }
+    free(board -> path[ZERO]);
+    free(board -> path[ONE]);
+    memset(board, ZERO, sizeof(MappedGs));
+    board -> fd[ZERO] = board -> fd[ONE] = -ONE;
+
+return done;
+}
@@ -0,0 +1,39 @@
+#ifndef GOL_MAPPED_H
+#define GOL_MAPPED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Out of core: the board stays in a packed gamestate file (GoL_file.h, rows padded to
+ * whole words) mapped into memory, and a generation streams through it top to bottom
+ * with processRow(), writing into a second mapped file of the same size. Rows already
+ * used are dropped from memory as the window moves on, so only a few are resident.
+ * The two files swap roles every generation.
+ */
+
+#define MAPPED_CHUNK (32L << 20) /* Bytes streamed between two drops of the rows left behind */
+
+struct mappedGs
+{
+    int rows;
+    int cols;
+    int words;
+    size_t rowBytes;
+    size_t size;            /* Whole file, header included */
+    int fd[TWO];
+    unsigned char *map[TWO];
+    char *path[TWO];        /* The board file and its scratch twin (path + ".next") */
+    int current;            /* Which of the two holds the present generation */
+};
+typedef struct mappedGs MappedGs;
+
+int createMapped(const char *path, int rows, int cols); /* Empty board file, RETURN 1 => OK! */
+int openMapped(MappedGs *board, const char *path); /* RETURN 1 => OK! */
+uint64_t *mappedRow(MappedGs *board, int row); /* Present generation */
+long long stepMapped(MappedGs *board); /* One generation, RETURN its population */
+int closeMapped(MappedGs *board); /* Leaves the last generation in the board file, RETURN 1 => OK! */
+
+#endif /* GOL_MAPPED_H */
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "GoL_noise.h"
+
+static uint64_t mix64(uint64_t x)
+{/* SplitMix64's finalizer */
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+
+return x ^ (x >> 31);
+}
+
+static uint64_t toFraction(double p)
+{
+    if(p >= 1.0) { return NOISE_ONE; }
+
+return (uint64_t) (p * (double) NOISE_ONE + 0.5);
+}
+
+static uint64_t oneFlip(uint64_t p, uint64_t flip)
+{/* Probability of ending up alive: p, then flipped with probability flip (both out of NOISE_ONE) */
+    if(flip >= NOISE_ONE) { return NOISE_ONE - p; }
+    if(p >= NOISE_ONE) { return NOISE_ONE - flip; }
+
+return ((p * (NOISE_ONE - flip)) + ((NOISE_ONE - p) * flip)) >> NOISE_BITS; /* < 2^64 with both below 1 */
+}
+
+int parseNoise(NoiseRule *rule, const char *text) /* RETURN 1 => OK! */
+{
+    double birth, survive, flip;
+    unsigned long long seed = ONE;
+    int used = ZERO, more = ZERO;
+
+    if(sscanf(text, "B%lf,S%lf,N%lf%n", &birth, &survive, &flip, &used) != THREE) { return ZERO; }
+    if(text[used] != '\0' && (sscanf(text + used, ",seed=%llu%n", &seed, &more) != ONE || text[used + more] != '\0')) { return ZERO; }
+    if(!(birth >= 0.0 && birth <= 1.0) || !(survive >= 0.0 && survive <= 1.0) || !(flip >= 0.0 && flip <= 1.0)) { return ZERO; } /* NaN fails too */
+
+    rule -> birth = toFraction(birth);
+    rule -> survive = toFraction(survive);
+    rule -> flip = toFraction(flip);
+    rule -> seed = seed;
+
+return ONE;
+}
+
+static uint64_t chance(uint64_t key, uint64_t counter, const uint64_t p[THREE], const uint64_t cells[THREE])
+{/* A cell of cells[k] ends up alive with probability p[k], i.e. U < p[k] with U's bits drawn from the top, 64 cells a draw */
+    uint64_t less = ZERO, open = ZERO, sure = ZERO, random, digits;
+    int bit, k;
+
+    for(k = ZERO; k < THREE; k++)
+    {/* Certain and impossible cells need no draws */
+        if(p[k] >= NOISE_ONE) { sure |= cells[k]; }
+        else if(p[k]) { open |= cells[k]; }
+    }
+    for(bit = NOISE_BITS - ONE; bit >= ZERO && open; bit--, counter++)
+    {
+        random = mix64(key + (counter * 0x9e3779b97f4a7c15ULL)); /* Bit c: the next bit of cell c's U */
+        digits = (cells[ZERO] & (ZERO - ((p[ZERO] >> bit) & ONE))) | (cells[ONE] & (ZERO - ((p[ONE] >> bit) & ONE))) | (cells[TWO] & (ZERO - ((p[TWO] >> bit) & ONE)));
+        less |= open & digits & ~random; /* U has a 0 where p has a 1 => U < p */
+        open &= ~(digits ^ random);      /* Still equal so far */
+    }
+
+return less | sure; /* Still open => U == p, not less */
+}
+
+void stepNoise(const NoiseRule *rule, Gs *states, long generation) /* Same rule, seed and generation => same result */
+{/* Each cell's fate is one draw: born / kept by the rule and not flipped, or flipped */
+    size_t words = (size_t) states -> words;
+    uint64_t key = mix64(rule -> seed ^ mix64((uint64_t) generation)), *swap, p[THREE], cells[THREE];
+    int row, word;
+
+    p[ZERO] = oneFlip(rule -> birth, rule -> flip);
+    p[ONE] = oneFlip(rule -> survive, rule -> flip);
+    p[TWO] = rule -> flip;
+    for(row = ONE; row < states -> rows - ONE; row++)
+    {
+        const uint64_t *mid = states -> gameState1 + (row * words);
+        uint64_t *out = states -> gameState2 + (row * words);
+
+        processRow(mid - words, mid, mid + words, out, states -> words);
+        for(word = ZERO; word < states -> words; word++)
+        {/* Counters (word, draw) never overlap: 32 draws at most per word */
+            cells[ZERO] = out[word] & ~mid[word]; /* Born by the rule */
+            cells[ONE] = out[word] & mid[word];   /* Kept by the rule */
+            cells[TWO] = ~out[word];              /* Dead by the rule */
+            out[word] = chance(key, (((uint64_t) row * words) + (uint64_t) word) * NOISE_BITS, p, cells);
+        }
+        markWords(states, row, mid, out);
+    }
+    /* Flow of Time, flips in the dead edge and the padding are undone */
+    swap = states -> gameState1;
+    states -> gameState1 = states -> gameState2;
+    states -> gameState2 = swap;
+    deadEdge(states);
+
+return;
+}
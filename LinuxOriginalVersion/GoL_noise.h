@@ -0,0 +1,35 @@
+#ifndef GOL_NOISE_H
+#define GOL_NOISE_H
+
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Stochastic Life: a cell Conway's rule would give birth to is born with probability B,
+ * a cell it would keep survives with probability S, and then any cell flips with
+ * probability N. Random bits come from a counter-based generator, a pure function of
+ * (seed, generation, board word, draw), so a run only depends on its seed: not on the
+ * order words are stepped in or on how many threads or vector lanes step them.
+ * A cell's fate is one draw: alive with probability B or S (not flipped) or their flip, N
+ * for a cell the rule leaves dead. 64 random 32-bit fractions are compared with those
+ * probabilities at once, a bit plane at a time from the top, until every cell is decided
+ * (a few draws per word; none when every probability is 0 or 1, as in "B1,S1,N0").
+ */
+
+#define NOISE_BITS 32
+#define NOISE_ONE (1ULL << NOISE_BITS) /* Probability 1 */
+
+struct noiseRule
+{/* "B0.95,S0.99,N0.0001" or with a seed, "B0.95,S0.99,N0.0001,seed=7" (Conway's Life is "B1,S1,N0") */
+    uint64_t birth;   /* Out of NOISE_ONE */
+    uint64_t survive;
+    uint64_t flip;
+    uint64_t seed;
+};
+typedef struct noiseRule NoiseRule;
+
+int parseNoise(NoiseRule *rule, const char *text); /* RETURN 1 => OK! */
+void stepNoise(const NoiseRule *rule, Gs *states, long generation); /* Same rule, seed and generation => same result */
+
+#endif /* GOL_NOISE_H */
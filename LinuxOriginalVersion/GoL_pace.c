@@ -0,0 +1,114 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <time.h>
+#include <sys/timerfd.h>
+
+#include "GoL_board.h"
+#include "GoL_pace.h"
+
+#define NANOS 1000000000L
+
+static long long nanosOf(const struct timespec *when)
+{
+return ((long long) when -> tv_sec * NANOS) + when -> tv_nsec;
+}
+
+static void addNanos(struct timespec *when, long long nanos)
+{
+    nanos += when -> tv_nsec;
+    when -> tv_sec += (time_t) (nanos / NANOS);
+    when -> tv_nsec = (long) (nanos % NANOS);
+
+return;
+}
+
+void initPacer(Pacer *pace, long rate)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    pace -> rate = rate;
+    pace -> period = (rate > ZERO) ? NANOS / rate : ZERO;
+    pace -> deadline = now;
+    addNanos(&pace -> deadline, pace -> period);
+    pace -> nextDraw = now;
+    pace -> overruns = ZERO;
+    pace -> skipped = ZERO;
+    pace -> lateNs = ZERO;
+    pace -> since = now;
+    pace -> generations = ZERO;
+    pace -> achieved = ZERO;
+
+return;
+}
+
+int armPacer(Pacer *pace, int timer) /* Sets timerfd to the next deadline, 0 => as fast as possible */
+{
+    struct itimerspec when;
+
+    if(pace -> rate == ZERO) { return ZERO; }
+
+    when.it_interval.tv_sec = ZERO;
+    when.it_interval.tv_nsec = ZERO;
+    when.it_value = pace -> deadline;
+    timerfd_settime(timer, TFD_TIMER_ABSTIME, &when, NULL);
+
+return ONE;
+}
+
+void waitPacer(Pacer *pace)
+{/* Absolute deadline: time spent computing and drawing is not added on top of the period */
+    if(pace -> rate == ZERO) { return; }
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &pace -> deadline, NULL) == EINTR) { /* Again */ }
+
+return;
+}
+
+int tickPacer(Pacer *pace) /* After each generation, RETURN 1 => draw it */
+{
+    struct timespec now;
+    long long elapsed;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pace -> generations++;
+    elapsed = nanosOf(&now) - nanosOf(&pace -> since);
+    if(elapsed >= NANOS)
+    {
+        pace -> achieved = (double) pace -> generations * NANOS / (double) elapsed;
+        pace -> since = now;
+        pace -> generations = ZERO;
+    }
+
+    if(pace -> rate == ZERO)
+    {/* Step nonstop, only draw FAST_FRAME_RATE frames per second */
+        if(nanosOf(&now) < nanosOf(&pace -> nextDraw))
+        {
+            pace -> skipped++;
+
+        return ZERO;
+        }
+        pace -> nextDraw = now;
+        addNanos(&pace -> nextDraw, NANOS / FAST_FRAME_RATE);
+
+    return ONE;
+    }
+
+    pace -> lateNs = (long) (nanosOf(&now) - nanosOf(&pace -> deadline));
+    addNanos(&pace -> deadline, pace -> period);
+    if(nanosOf(&now) < nanosOf(&pace -> deadline)) { return ONE; /* On time, draw it */ }
+
+    /* Already past the next deadline */
+    pace -> overruns++;
+    if((nanosOf(&now) - nanosOf(&pace -> deadline)) > (long long) MAX_BEHIND * pace -> period)
+    {/* Too far behind to catch up, restart the schedule from now (and show where we are) */
+        pace -> deadline = now;
+        addNanos(&pace -> deadline, pace -> period);
+
+    return ONE;
+    }
+    pace -> skipped++; /* Skip drawing to catch up */
+
+return ZERO;
+}
@@ -0,0 +1,29 @@
+#ifndef GOL_PACE_H
+#define GOL_PACE_H
+
+#include <time.h>
+
+#define FAST_FRAME_RATE 30 /* Frames per second drawn in "as fast as possible" mode */
+#define MAX_BEHIND 8       /* Periods behind before the schedule is given up and restarted */
+
+struct pacer
+{/* All times are absolute CLOCK_MONOTONIC */
+    long rate;                /* Generations per second, 0 => as fast as possible */
+    long period;              /* Nanoseconds */
+    struct timespec deadline; /* When the next generation is due */
+    struct timespec nextDraw; /* As fast as possible: when the next frame is due */
+    long overruns;            /* Generations computed after their deadline had passed */
+    long skipped;             /* Frames not drawn to catch up */
+    long lateNs;              /* How late the last generation was */
+    struct timespec since;    /* Start of the current rate measurement */
+    long generations;         /* Generations since then */
+    double achieved;          /* Measured generations per second */
+};
+typedef struct pacer Pacer;
+
+void initPacer(Pacer *pace, long rate);
+int armPacer(Pacer *pace, int timer); /* Sets timerfd to the next deadline, 0 => as fast as possible */
+void waitPacer(Pacer *pace);          /* Sleeps until the next deadline */
+int tickPacer(Pacer *pace);           /* After each generation, RETURN 1 => draw it */
+
+#endif /* GOL_PACE_H */
@@ -0,0 +1,53 @@
+#ifndef GOL_PROTOCOL_H
+#define GOL_PROTOCOL_H
+
+#include <stdint.h>
+
+/*
+ * Wire format of GoL_daemon (Unix domain socket, host byte order, no padding).
+ * Every request is a golRequest header + `length` payload bytes and gets exactly
+ * one golReply header + `length` payload bytes back, in order.
+ * Coordinates are board cells, (0, 0) is the top left corner of the dead edge.
+ */
+
+#define GOL_SOCKET "/tmp/gol.sock"
+#define GOL_MAX_PAYLOAD (64u << 20)
+
+enum golOp
+{                     /* Request payload                          -> Reply payload */
+    GOL_CREATE = 1,   /* u32 rows, u32 cols (dead edge included)  -> u32 session */
+    GOL_DESTROY,      /* -                                        -> - */
+    GOL_CLEAR,        /* -                                        -> - */
+    GOL_PATTERN,      /* u32 pattern, u32 transform, u32 count, count * (i32 x, i32 y) -> - */
+    GOL_SET_CELLS,    /* u32 live, u32 count, count * (i32 x, i32 y) -> - */
+    GOL_STEP,         /* u32 generations                          -> u64 generation */
+    GOL_POPULATION,   /* -                                        -> u64 population, u64 generation */
+    GOL_REGION,       /* i32 x, i32 y, i32 width, i32 height      -> u64 population */
+    GOL_READ,         /* i32 y, i32 height                        -> height * words * u64 (packed rows) */
+    GOL_DELTA         /* -                                        -> n * (u32 row, u32 word, u64 flipped) since the last STEP began */
+};
+
+enum golStatus
+{
+    GOL_OK = 0,
+    GOL_BAD_REQUEST = -1,
+    GOL_NO_SESSION = -2,
+    GOL_NO_MEMORY = -3
+};
+
+struct golRequest
+{
+    uint8_t op;
+    uint8_t flags;    /* Unused, 0 */
+    uint16_t reserved;
+    uint32_t session; /* Ignored by GOL_CREATE */
+    uint32_t length;
+} __attribute__((packed));
+
+struct golReply
+{
+    int32_t status;
+    uint32_t length;
+} __attribute__((packed));
+
+#endif /* GOL_PROTOCOL_H */
@@ -0,0 +1,198 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_pyramid.h"
+
+static void addUp(Pyramid *pyramid, int top, int left, int bottom, int right)
+{/* The levels above the 8 x 8 blocks from the one below, over the blocks [top, bottom] x [left, right] of level 0 recounted */
+    int level, blockRow, blockCol;
+
+    for(level = ONE; level < pyramid -> levels; level++)
+    {
+        const uint64_t *below = pyramid -> counts[level - ONE];
+        int belowWide = pyramid -> width[level - ONE], belowHigh = pyramid -> height[level - ONE];
+
+        for(blockRow = top >> level; blockRow <= bottom >> level; blockRow++)
+        {
+            const uint64_t *upper = below + ((size_t) (blockRow * TWO) * (size_t) belowWide);
+            const uint64_t *lower = (blockRow * TWO + ONE < belowHigh) ? upper + belowWide : NULL;
+            uint64_t *out = pyramid -> counts[level] + ((size_t) blockRow * (size_t) pyramid -> width[level]);
+
+            for(blockCol = left >> level; blockCol <= right >> level; blockCol++)
+            {
+                int west = blockCol * TWO, east = (west + ONE < belowWide) ? west + ONE : -ONE;
+
+                out[blockCol] = upper[west] + ((east >= ZERO) ? upper[east] : ZERO);
+                if(lower != NULL) { out[blockCol] += lower[west] + ((east >= ZERO) ? lower[east] : ZERO); }
+            }
+        }
+    }
+
+return;
+}
+
+int newPyramid(Pyramid *pyramid, Gs *states) /* Tracks the board too, RETURN 1 => OK! */
+{
+    int level = ZERO;
+
+    memset(pyramid, ZERO, sizeof(Pyramid));
+    pyramid -> rows = states -> rows;
+    pyramid -> cols = states -> cols;
+    pyramid -> words = states -> words;
+    pyramid -> width[ZERO] = (states -> cols + PYRAMID_BLOCK - ONE) / PYRAMID_BLOCK;
+    pyramid -> height[ZERO] = (states -> rows + PYRAMID_BLOCK - ONE) / PYRAMID_BLOCK;
+    while(ONE)
+    {/* Up to a single block */
+        if((pyramid -> counts[level] = calloc((size_t) pyramid -> width[level] * (size_t) pyramid -> height[level], sizeof(uint64_t))) == NULL)
+        {
+            freePyramid(pyramid);
+
+        return ZERO;
+        }
+        pyramid -> levels = ++level;
+        if(pyramid -> width[level - ONE] == ONE && pyramid -> height[level - ONE] == ONE) { break; }
+        pyramid -> width[level] = (pyramid -> width[level - ONE] + ONE) / TWO;
+        pyramid -> height[level] = (pyramid -> height[level - ONE] + ONE) / TWO;
+    }
+
+    /* Every bit set: the first sync counts the whole board */
+    if(trackGs(states) == ZERO)
+    {
+        freePyramid(pyramid);
+
+    return ZERO;
+    }
+    pyramid -> stamp = states -> stamp - ONE;
+    syncPyramid(pyramid, states);
+
+return ONE;
+}
+
+long syncPyramid(Pyramid *pyramid, Gs *states) /* RETURN 8 x 8 blocks recounted */
+{/* A dirty bit is one word of a band of 8 rows: 8 blocks, counted together a byte each */
+    size_t words = (size_t) pyramid -> words, bits = (size_t) pyramid -> height[ZERO] * words, at;
+    int band, word, row, byte, lastRow, top = pyramid -> height[ZERO], left = pyramid -> width[ZERO], bottom = -ONE, right = -ONE, chains;
+    long recounted = ZERO, dirtyWords = ZERO;
+
+    if(states -> stamp == pyramid -> stamp) { return ZERO; } /* Nothing marked since the last sync */
+    /* A few dirty words scattered over the board: only their chains up, else one pass over the box around them */
+    for(at = ZERO; at < WORDS_FOR(bits); at++) { dirtyWords += __builtin_popcountll(states -> dirty[at]); }
+    chains = (dirtyWords * (long) (pyramid -> levels + 8) < ((long) pyramid -> width[ZERO] * pyramid -> height[ZERO]) / THREE);
+    for(at = ZERO; at < WORDS_FOR(bits); at++)
+    {
+        uint64_t dirty = states -> dirty[at];
+
+        states -> dirty[at] = ZERO;
+        for(; dirty != ZERO; dirty &= dirty - ONE)
+        {
+            size_t bit = (at * WORD_BITS) + (size_t) __builtin_ctzll(dirty);
+            uint64_t counts;
+
+            if(bit >= bits) { break; } /* markAll() padding */
+            band = (int) (bit / words);
+            word = (int) (bit % words);
+            if(band < top) { top = band; }
+            if(band > bottom) { bottom = band; }
+            if(word * 8 < left) { left = word * 8; }
+            if(word * 8 > right) { right = word * 8; }
+            lastRow = (band + ONE) * PYRAMID_BLOCK;
+            if(lastRow > pyramid -> rows) { lastRow = pyramid -> rows; }
+            for(row = band * PYRAMID_BLOCK, counts = ZERO; row < lastRow; row++)
+            {/* Popcount of every byte at once, 8 rows of at most 8 fit a byte */
+                uint64_t cells = GS_ROW(states, row)[word];
+
+                cells -= (cells >> ONE) & 0x5555555555555555ULL;
+                cells = (cells & 0x3333333333333333ULL) + ((cells >> TWO) & 0x3333333333333333ULL);
+                counts += (cells + (cells >> FOUR)) & 0x0f0f0f0f0f0f0f0fULL;
+            }
+            for(byte = ZERO; byte < 8 && (word * 8) + byte < pyramid -> width[ZERO]; byte++)
+            {
+                pyramid -> counts[ZERO][((size_t) band * (size_t) pyramid -> width[ZERO]) + (size_t) (word * 8) + (size_t) byte] = (counts >> (byte * 8)) & 0xff;
+                recounted++;
+            }
+            /* Ancestors shared with a later dirty word are summed again after it */
+            if(chains) { addUp(pyramid, band, word * 8, band, (word * 8) + byte - ONE); }
+        }
+    }
+    if(recounted > ZERO && !chains)
+    {/* Once for all the blocks recounted, the last dirty word's 8 blocks included */
+        right = (right + 7 < pyramid -> width[ZERO]) ? right + 7 : pyramid -> width[ZERO] - ONE;
+        addUp(pyramid, top, left, bottom, right);
+    }
+    pyramid -> stamp = states -> stamp;
+
+return recounted;
+}
+
+uint64_t blockCount(const Pyramid *pyramid, int side, int blockRow, int blockCol) /* side: a power of 2 >= 8 */
+{
+    int level = ZERO;
+
+    while((PYRAMID_BLOCK << level) < side && level < pyramid -> levels - ONE) { level++; }
+    if((PYRAMID_BLOCK << level) < side)
+    {/* Bigger than the whole board: only the first block has anything */
+        return (blockRow == ZERO && blockCol == ZERO) ? pyramid -> counts[level][ZERO] : ZERO;
+    }
+    if(blockRow < ZERO || blockCol < ZERO || blockRow >= pyramid -> height[level] || blockCol >= pyramid -> width[level]) { return ZERO; }
+
+return pyramid -> counts[level][((size_t) blockRow * (size_t) pyramid -> width[level]) + (size_t) blockCol];
+}
+
+static uint64_t countIn(Pyramid *pyramid, Gs *states, int level, int blockRow, int blockCol, int left, int top, int right, int bottom)
+{/* Whole blocks from the sums, only the 8 x 8 blocks cut by the region's border from the cells */
+    int side = PYRAMID_BLOCK << level, fromRow = blockRow * side, fromCol = blockCol * side;
+    int toRow = fromRow + side, toCol = fromCol + side, row;
+    uint64_t liveCount = ZERO;
+
+    if(blockRow >= pyramid -> height[level] || blockCol >= pyramid -> width[level]) { return ZERO; }
+    if(toRow <= top || fromRow >= bottom || toCol <= left || fromCol >= right) { return ZERO; }
+    if(fromRow >= top && toRow <= bottom && fromCol >= left && toCol <= right)
+    {
+        return pyramid -> counts[level][((size_t) blockRow * (size_t) pyramid -> width[level]) + (size_t) blockCol];
+    }
+    if(level == ZERO)
+    {
+        if(fromRow < top) { fromRow = top; }
+        if(toRow > bottom) { toRow = bottom; }
+        if(fromCol < left) { fromCol = left; }
+        if(toCol > right) { toCol = right; }
+        for(row = fromRow; row < toRow; row++) { liveCount += (uint64_t) countRange(GS_ROW(states, row), fromCol, toCol); }
+
+    return liveCount;
+    }
+
+    liveCount += countIn(pyramid, states, level - ONE, blockRow * TWO, blockCol * TWO, left, top, right, bottom);
+    liveCount += countIn(pyramid, states, level - ONE, blockRow * TWO, (blockCol * TWO) + ONE, left, top, right, bottom);
+    liveCount += countIn(pyramid, states, level - ONE, (blockRow * TWO) + ONE, blockCol * TWO, left, top, right, bottom);
+    liveCount += countIn(pyramid, states, level - ONE, (blockRow * TWO) + ONE, (blockCol * TWO) + ONE, left, top, right, bottom);
+
+return liveCount;
+}
+
+uint64_t regionCount(Pyramid *pyramid, Gs *states, int x, int y, int width, int height) /* Syncs first */
+{
+    long right = (long) x + width, bottom = (long) y + height;
+
+    syncPyramid(pyramid, states);
+    if(x < ZERO) { x = ZERO; }
+    if(y < ZERO) { y = ZERO; }
+    if(right > pyramid -> cols) { right = pyramid -> cols; }
+    if(bottom > pyramid -> rows) { bottom = pyramid -> rows; }
+    if(x >= right || y >= bottom) { return ZERO; }
+
+return countIn(pyramid, states, pyramid -> levels - ONE, ZERO, ZERO, x, y, (int) right, (int) bottom);
+}
+
+void freePyramid(Pyramid *pyramid)
+{
+    int level;
+
+    for(level = ZERO; level < PYRAMID_MAX_LEVELS; level++)
+    {
+        free(pyramid -> counts[level]);
+        pyramid -> counts[level] = NULL;
+    }
+    pyramid -> levels = ZERO;
+
+return;
+}
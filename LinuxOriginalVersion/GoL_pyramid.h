@@ -0,0 +1,40 @@
+#ifndef GOL_PYRAMID_H
+#define GOL_PYRAMID_H
+
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Density pyramid: live cells per 8 x 8 block, per 16 x 16 block, ... up to one block
+ * for the whole board, blocks aligned on multiples of their side. The board is tracked
+ * (trackGs()): syncPyramid() does nothing while its stamp is unchanged, else recounts
+ * only the 8 x 8 blocks under the dirty bits the steps and edits marked and adds the
+ * levels above up again, so zoomed-out views and region counts read a few hundred sums
+ * instead of every cell. One pyramid per board, it clears the dirty bits.
+ */
+
+#define PYRAMID_SHIFT 3                     /* Smallest block: 8 x 8 cells (a byte of 8 rows) */
+#define PYRAMID_BLOCK (ONE << PYRAMID_SHIFT)
+#define PYRAMID_MAX_LEVELS 32
+
+struct pyramid
+{
+    int rows;
+    int cols;
+    int words;
+    int levels;
+    int width[PYRAMID_MAX_LEVELS];     /* Blocks across on each level, level k blocks are (8 << k) cells wide */
+    int height[PYRAMID_MAX_LEVELS];
+    uint64_t *counts[PYRAMID_MAX_LEVELS];
+    unsigned long stamp;               /* The board's stamp at the last syncPyramid() */
+};
+typedef struct pyramid Pyramid;
+
+int newPyramid(Pyramid *pyramid, Gs *states); /* Tracks the board too, RETURN 1 => OK! */
+long syncPyramid(Pyramid *pyramid, Gs *states); /* RETURN 8 x 8 blocks recounted */
+uint64_t blockCount(const Pyramid *pyramid, int side, int blockRow, int blockCol); /* side: a power of 2 >= 8 */
+uint64_t regionCount(Pyramid *pyramid, Gs *states, int x, int y, int width, int height); /* Syncs first (free when nothing changed) */
+void freePyramid(Pyramid *pyramid);
+
+#endif /* GOL_PYRAMID_H */
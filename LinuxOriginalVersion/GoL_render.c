@@ -0,0 +1,256 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include "GoL_render.h"
+
+#define MAX_ZOOM 65536
+#define BYTES_PER_COLUMN 6 /* Worst case: "[]" plus one colour change every 2 columns */
+#define BYTES_PER_LINE 32  /* Colours, clear to end of line, '\n' */
+#define HEAT_BYTES_PER_COLUMN 26 /* Two 256 colour changes and a half block, every column */
+
+static const char *modeNames[] = { "cells", "half", "braille" };
+/* 256 colour palette, black through red and yellow to white, by heat / 16 */
+static const int heatColours[16] = { 16, 52, 88, 124, 160, 196, 202, 208, 214, 220, 226, 227, 228, 229, 230, 231 };
+
+int renderModeFromName(const char *name)
+{
+    int mode;
+
+    for(mode = RENDER_CELLS; mode <= RENDER_BRAILLE; mode++) { if(strcmp(modeNames[mode], name) == ZERO) { return mode; } }
+
+return -ONE;
+}
+
+void initView(View *view, int mode, int statusLines)
+{
+    struct winsize size;
+
+    view -> mode = mode;
+    view -> X = ONE; /* Skip the dead edge */
+    view -> Y = ONE;
+    view -> zoom = ONE;
+    view -> threshold = ZERO;
+    view -> width = 80;
+    view -> height = 24;
+    if(ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == ZERO && size.ws_col > ZERO && size.ws_row > ZERO)
+    {
+        view -> width = size.ws_col;
+        view -> height = size.ws_row;
+    }
+    view -> height -= statusLines + ONE; /* Keep the cursor line free, no scrolling */
+    if(view -> height < ONE) { view -> height = ONE; }
+    view -> pyramid = NULL;
+    view -> heat = NULL;
+    view -> heatKind = HEAT_AGE;
+    view -> buffer = NULL;
+    view -> capacity = ZERO;
+
+return;
+}
+
+void freeView(View *view)
+{
+    free(view -> buffer);
+    view -> buffer = NULL;
+    view -> capacity = ZERO;
+
+return;
+}
+
+void panView(View *view, Gs *states, int dx, int dy)
+{
+    view -> X += dx;
+    view -> Y += dy;
+    if(view -> X > states -> cols - TWO) { view -> X = states -> cols - TWO; }
+    if(view -> Y > states -> rows - TWO) { view -> Y = states -> rows - TWO; }
+    if(view -> X < ONE) { view -> X = ONE; }
+    if(view -> Y < ONE) { view -> Y = ONE; }
+
+return;
+}
+
+void zoomView(View *view, int zoomIn)
+{
+    if(zoomIn && view -> zoom > ONE) { view -> zoom /= TWO; }
+    else if(!zoomIn && view -> zoom < MAX_ZOOM) { view -> zoom *= TWO; }
+
+return;
+}
+
+static int dotAt(Gs *states, const View *view, int dotRow, int dotCol)
+{/* A dot is zoom x zoom cells, lit when dense enough */
+    int row = view -> Y + (dotRow * view -> zoom), col = view -> X + (dotCol * view -> zoom);
+    int lastRow = row + view -> zoom, lastCol = col + view -> zoom;
+    long liveCount = ZERO;
+
+    if(view -> pyramid != NULL && view -> zoom >= PYRAMID_BLOCK)
+    {/* One sum instead of zoom x zoom cells */
+        liveCount = (long) blockCount(view -> pyramid, view -> zoom, (view -> Y / view -> zoom) + dotRow, (view -> X / view -> zoom) + dotCol);
+        if(view -> threshold == ZERO) { return liveCount > ZERO; }
+
+    return (liveCount * 100) >= ((long) view -> threshold * view -> zoom * view -> zoom);
+    }
+    if(row >= states -> rows - ONE || col >= states -> cols - ONE) { return DEAD; }
+    if(view -> zoom == ONE) { return GET_CELL(states, row, col); }
+
+    if(lastRow > states -> rows - ONE) { lastRow = states -> rows - ONE; }
+    if(lastCol > states -> cols - ONE) { lastCol = states -> cols - ONE; }
+    for(; row < lastRow; row++) { liveCount += countRange(GS_ROW(states, row), col, lastCol); }
+
+    if(view -> threshold == ZERO) { return liveCount > ZERO; }
+
+return (liveCount * 100) >= ((long) view -> threshold * view -> zoom * view -> zoom);
+}
+
+static int heatDotAt(Gs *states, const View *view, int dotRow, int dotCol)
+{/* The palette colour of the hottest cell of the dot */
+    int row = view -> Y + (dotRow * view -> zoom), col = view -> X + (dotCol * view -> zoom);
+    int lastRow = row + view -> zoom, lastCol = col + view -> zoom, hottest = ZERO, c;
+
+    if(view -> pyramid != NULL && view -> zoom >= PYRAMID_BLOCK)
+    {/* Same snapped grid as dotAt() */
+        row = ((view -> Y / view -> zoom) + dotRow) * view -> zoom;
+        col = ((view -> X / view -> zoom) + dotCol) * view -> zoom;
+        lastRow = row + view -> zoom;
+        lastCol = col + view -> zoom;
+    }
+    if(lastRow > states -> rows - ONE) { lastRow = states -> rows - ONE; }
+    if(lastCol > states -> cols - ONE) { lastCol = states -> cols - ONE; }
+    for(; row < lastRow; row++)
+    {
+        for(c = col; c < lastCol; c++) { if(HEAT_AT(view -> heat, view -> heatKind, row, c) > hottest) { hottest = HEAT_AT(view -> heat, view -> heatKind, row, c); } }
+    }
+
+return heatColours[hottest >> FOUR];
+}
+
+static char *putUtf8(char *out, unsigned int codePoint)
+{/* Only used for U+0800 - U+FFFF (block elements and braille) */
+    *out++ = (char) (0xe0 | (codePoint >> 12));
+    *out++ = (char) (0x80 | ((codePoint >> 6) & 0x3f));
+    *out++ = (char) (0x80 | (codePoint & 0x3f));
+
+return out;
+}
+
+size_t renderGs(Gs *states, View *view, const char *status)
+{
+    static const unsigned int brailleDots[FOUR][TWO] = { { 0x01, 0x08 }, { 0x02, 0x10 }, { 0x04, 0x20 }, { 0x40, 0x80 } };
+    int dotsHigh = (view -> mode == RENDER_BRAILLE) ? FOUR : (view -> mode == RENDER_HALF) ? TWO : ONE;
+    int dotsWide = (view -> mode == RENDER_BRAILLE) ? TWO : ONE;
+    int columns = (view -> mode == RENDER_CELLS) ? view -> width / TWO : view -> width;
+    int lines = view -> height, line, column;
+    int fromRow = view -> Y, fromCol = view -> X;
+    int dotRows, dotCols;
+    size_t needed = strlen(status) + 64 + (size_t) lines * ((size_t) view -> width * ((view -> heat != NULL) ? HEAT_BYTES_PER_COLUMN : BYTES_PER_COLUMN) + BYTES_PER_LINE);
+    char *out;
+
+    if(view -> pyramid != NULL && view -> zoom >= PYRAMID_BLOCK)
+    {/* Blocks start on multiples of their side */
+        syncPyramid(view -> pyramid, states);
+        fromRow -= fromRow % view -> zoom;
+        fromCol -= fromCol % view -> zoom;
+    }
+    /* Dots left between the view corner and the dead edge */
+    dotRows = (states -> rows - ONE - fromRow + view -> zoom - ONE) / view -> zoom;
+    dotCols = (states -> cols - ONE - fromCol + view -> zoom - ONE) / view -> zoom;
+    if(needed > view -> capacity)
+    {
+        char *grown = realloc(view -> buffer, needed);
+
+        if(grown == NULL) { return ZERO; }
+        view -> buffer = grown;
+        view -> capacity = needed;
+    }
+
+    if(lines > (dotRows + dotsHigh - ONE) / dotsHigh) { lines = (dotRows + dotsHigh - ONE) / dotsHigh; }
+    if(columns > (dotCols + dotsWide - ONE) / dotsWide) { columns = (dotCols + dotsWide - ONE) / dotsWide; }
+
+    out = view -> buffer;
+    out += sprintf(out, "\033[H\033[0m%s", status);
+
+    for(line = ZERO; line < lines; line++)
+    {
+        int lastColour = -ONE;
+
+        if(view -> mode != RENDER_CELLS) { out += sprintf(out, "%s", "\033[97m\033[40m"); }
+        for(column = ZERO; column < columns; column++)
+        {
+            if(view -> mode == RENDER_BRAILLE)
+            {
+                unsigned int glyph = ZERO;
+                int dy, dx;
+
+                for(dy = ZERO; dy < FOUR; dy++)
+                {
+                    for(dx = ZERO; dx < TWO; dx++) { if(dotAt(states, view, (line * FOUR) + dy, (column * TWO) + dx)) { glyph |= brailleDots[dy][dx]; } }
+                }
+                out = putUtf8(out, 0x2800 + glyph);
+            }
+            else if(view -> mode == RENDER_HALF && view -> heat != NULL)
+            {/* Upper dot in front, lower dot behind */
+                int upper = heatDotAt(states, view, line * TWO, column), lower = heatDotAt(states, view, (line * TWO) + ONE, column);
+
+                out += sprintf(out, "\033[38;5;%dm\033[48;5;%dm", upper, lower);
+                out = putUtf8(out, 0x2580); /* UPPER HALF BLOCK */
+            }
+            else if(view -> mode == RENDER_HALF)
+            {
+                int upper = dotAt(states, view, line * TWO, column), lower = dotAt(states, view, (line * TWO) + ONE, column);
+
+                if(upper && lower) { out = putUtf8(out, 0x2588); /* FULL BLOCK */ }
+                else if(upper) { out = putUtf8(out, 0x2580); /* UPPER HALF BLOCK */ }
+                else if(lower) { out = putUtf8(out, 0x2584); /* LOWER HALF BLOCK */ }
+                else { *out++ = ' '; }
+            }
+            else if(view -> heat != NULL)
+            {/* Live cells stay "[]" in white, on the heat of the dot */
+                int colour = heatDotAt(states, view, line, column), alive = dotAt(states, view, line, column);
+
+                if(colour != lastColour)
+                {
+                    out += sprintf(out, "\033[97m\033[48;5;%dm", colour);
+                    lastColour = colour;
+                }
+                *out++ = alive ? '[' : ' '; *out++ = alive ? ']' : ' ';
+            }
+            else
+            {
+                int colour = dotAt(states, view, line, column);
+
+                if(colour != lastColour)
+                {/* Only on change, not once per cell */
+                    if(colour == DEAD) { out += sprintf(out, "%s", "\033[30m\033[40m"); /* BLACK LETTERS & BLACK BG */ }
+                    else { out += sprintf(out, "%s", "\033[97m\033[107m"); /* WHITE LETTERS & WHITE BG */ }
+                    lastColour = colour;
+                }
+                *out++ = '['; *out++ = ']';
+            }
+        }
+        out += sprintf(out, "%s", "\033[30m\033[40m\033[K\n");
+    }
+    out += sprintf(out, "%s", "\033[0m\033[J");
+
+return (size_t) (out - view -> buffer);
+}
+
+void printGs(Gs *states, View *view, const char *status)
+{
+    size_t length = renderGs(states, view, status), written = ZERO;
+
+    fflush(stdout);
+    while(written < length)
+    {/* Normally a single write() per frame */
+        ssize_t done = write(STDOUT_FILENO, view -> buffer + written, length - written);
+
+        if(done <= ZERO) { break; }
+        written += (size_t) done;
+    }
+
+return;
+}
@@ -0,0 +1,40 @@
+#ifndef GOL_RENDER_H
+#define GOL_RENDER_H
+
+#include "GoL_board.h"
+#include "GoL_pyramid.h"
+#include "GoL_heat.h"
+
+enum renderMode
+{
+    RENDER_CELLS = 0, /* "[]" per dot, the classic look */
+    RENDER_HALF,      /* 1x2 dots per half-block character */
+    RENDER_BRAILLE    /* 2x4 dots per braille character */
+};
+
+struct viewPort
+{
+    int mode;
+    int X;         /* Board cell shown at the top left corner */
+    int Y;
+    int zoom;      /* A dot covers zoom x zoom board cells */
+    int threshold; /* % of live cells lighting a zoomed-out dot, 0 => any live cell */
+    int width;     /* Terminal columns */
+    int height;    /* Terminal rows available for the board */
+    Pyramid *pyramid; /* NULL => count cells, else zoomed-out dots are its blocks (grid snapped to them) */
+    const HeatMap *heat; /* NULL => plain, else cells & half modes are coloured by it (hottest cell of a dot) */
+    int heatKind;
+    char *buffer;  /* Whole frame, written at once */
+    size_t capacity;
+};
+typedef struct viewPort View;
+
+int renderModeFromName(const char *name); /* -1 if unknown */
+void initView(View *view, int mode, int statusLines);
+void freeView(View *view);
+void panView(View *view, Gs *states, int dx, int dy);
+void zoomView(View *view, int zoomIn);
+size_t renderGs(Gs *states, View *view, const char *status);
+void printGs(Gs *states, View *view, const char *status);
+
+#endif /* GOL_RENDER_H */
@@ -0,0 +1,245 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "GoL_search.h"
+
+int newSearch(Search *search, const Pattern *pattern, int margin) /* RETURN 0 => pattern plus margin wider than 64, or no memory */
+{
+    Pattern oriented;
+    int transform, o, row, col, live;
+
+    memset(search, ZERO, sizeof(Search));
+    search -> name = pattern -> name;
+    search -> margin = margin;
+    search -> population = patternPopulation(pattern);
+    if(margin < ZERO || search -> population == ZERO) { return ZERO; }
+    /* Turned or not, the window has to fit a word */
+    if(pattern -> rows + (TWO * margin) > WORD_BITS || pattern -> cols + (TWO * margin) > WORD_BITS) { return ZERO; }
+
+    for(transform = PATTERN_IDENTITY; transform < PATTERN_TRANSFORMS; transform++)
+    {
+        int n = search -> orientations, height, width;
+        uint64_t *want = search -> want[n];
+
+        transformPattern(pattern, transform, &oriented);
+        height = oriented.rows + (TWO * margin);
+        width = oriented.cols + (TWO * margin);
+
+        memset(want, ZERO, sizeof(search -> want[n]));
+        for(row = ZERO; row < oriented.rows; row++) { want[row + margin] = oriented.bits[row] << margin; }
+        search -> height[n] = height;
+        search -> width[n] = width;
+        for(row = ZERO; want[row] == ZERO; row++) { }
+        search -> anchorRow[n] = row;
+        search -> anchorCol[n] = __builtin_ctzll(want[row]);
+        search -> transform[n] = transform;
+
+        /* A symmetric pattern looks the same in several orientations: search each look once */
+        for(o = ZERO; o < n; o++)
+        {
+            if(search -> height[o] == height && search -> width[o] == width && memcmp(search -> want[o], want, sizeof(search -> want[n])) == ZERO) { break; }
+        }
+        if(o < n) { continue; }
+        search -> orientations++;
+
+        if((search -> checks[n] = malloc((size_t) height * (size_t) width * sizeof(SearchCheck))) == NULL)
+        {
+            freeSearch(search);
+
+        return ZERO;
+        }
+        for(live = ONE; live >= ZERO; live--)
+        {
+            for(row = ZERO; row < height; row++)
+            {
+                for(col = ZERO; col < width; col++)
+                {
+                    SearchCheck *check = &search -> checks[n][search -> checkCount[n]];
+                    int dr = row - search -> anchorRow[n], dc = col - search -> anchorCol[n], cell = (int) ((want[row] >> col) & ONE);
+
+                    if(abs(dr) <= ONE && abs(dc) <= ONE)
+                    {/* Checked by the block instead, once */
+                        search -> block[n] |= cell << (((dr + ONE) * THREE) + dc + ONE);
+                        search -> blockCare[n] |= ONE << (((dr + ONE) * THREE) + dc + ONE);
+                        continue;
+                    }
+                    if(cell != live) { continue; }
+                    check -> row = dr;
+                    check -> col = dc;
+                    check -> live = live;
+                    search -> checkCount[n]++;
+                }
+            }
+        }
+    }
+
+return ONE;
+}
+
+static void aroundCells(Gs *states, int row, int word, uint64_t around[9])
+{/* around[(dr + 1) * 3 + (dc + 1)] bit c => the cell (dr, dc) away from column (word * 64) + c */
+    int r;
+
+    for(r = ZERO; r < THREE; r++)
+    {/* Rows of live cells are inside the dead edge, the rows above and below exist */
+        const uint64_t *cells = GS_ROW(states, row - ONE + r);
+        uint64_t here = cells[word], before = (word > ZERO) ? cells[word - ONE] : ZERO, after = (word + ONE < states -> words) ? cells[word + ONE] : ZERO;
+
+        around[(r * THREE)] = (here << ONE) | (before >> 63);
+        around[(r * THREE) + ONE] = here;
+        around[(r * THREE) + TWO] = (here >> ONE) | (after << 63);
+    }
+
+return;
+}
+
+static uint64_t cellsAcross(Gs *states, int row, int word, int offset)
+{/* Bit c => the cell offset columns right of column (word * 64) + c, dead off the board */
+    const uint64_t *cells;
+    uint64_t here, beyond;
+
+    if(row < ZERO || row >= states -> rows) { return ZERO; }
+    cells = GS_ROW(states, row);
+    here = cells[word];
+    if(offset == ZERO) { return here; }
+    if(offset < ZERO)
+    {/* The window is at most 64 wide: the words either side are all it can reach */
+        beyond = (word > ZERO) ? cells[word - ONE] : ZERO;
+
+    return (here << -offset) | (beyond >> (WORD_BITS + offset));
+    }
+    beyond = (word + ONE < states -> words) ? cells[word + ONE] : ZERO;
+
+return (here >> offset) | (beyond << (WORD_BITS - offset));
+}
+
+static uint64_t matchWord(const Search *search, int o, Gs *states, int row, int word, uint64_t anchors)
+{/* Bit c => the window anchored at column (word * 64) + c matches, all 64 anchors at once */
+    const SearchCheck *check = search -> checks[o], *last = check + search -> checkCount[o];
+
+    for(; check < last && anchors; check++)
+    {
+        uint64_t cells = cellsAcross(states, row + check -> row, word, check -> col);
+
+        anchors &= check -> live ? cells : ~cells;
+    }
+
+return anchors;
+}
+
+static int addHit(Search *search, int row, int col, int transform) /* RETURN 0 => out of memory */
+{
+    if(search -> hitCount == search -> hitCapacity)
+    {
+        long capacity = (search -> hitCapacity == ZERO) ? 64 : search -> hitCapacity * TWO;
+        SearchHit *grown = realloc(search -> hits, (size_t) capacity * sizeof(SearchHit));
+
+        if(grown == NULL) { return ZERO; }
+        search -> hits = grown;
+        search -> hitCapacity = capacity;
+    }
+    search -> hits[search -> hitCount].row = row;
+    search -> hits[search -> hitCount].col = col;
+    search -> hits[search -> hitCount].transform = transform;
+    search -> hitCount++;
+
+return ONE;
+}
+
+long searchGs(Search *search, Gs *states, Pyramid *pyramid) /* pyramid may be NULL, RETURN hits (-1 => out of memory) */
+{
+    int tilesHigh = (states -> rows + SEARCH_TILE - ONE) / SEARCH_TILE, tilesWide = states -> words;
+    int tileRow, tileCol, row, lastRow, o, r, c;
+    size_t tiles = (size_t) tilesHigh * (size_t) tilesWide;
+
+    search -> hitCount = ZERO;
+    if(tiles > search -> tileCapacity)
+    {
+        uint64_t *grown = realloc(search -> tiles, tiles * sizeof(uint64_t));
+
+        if(grown == NULL) { return -ONE; }
+        search -> tiles = grown;
+        search -> tileCapacity = tiles;
+    }
+    if(pyramid != NULL)
+    {/* Tiles are the pyramid's 64 x 64 blocks */
+        syncPyramid(pyramid, states);
+        for(tileRow = ZERO; tileRow < tilesHigh; tileRow++)
+        {
+            for(tileCol = ZERO; tileCol < tilesWide; tileCol++) { search -> tiles[((size_t) tileRow * tilesWide) + tileCol] = blockCount(pyramid, SEARCH_TILE, tileRow, tileCol); }
+        }
+    }
+    else
+    {
+        memset(search -> tiles, ZERO, tiles * sizeof(uint64_t));
+        for(row = ZERO; row < states -> rows; row++)
+        {
+            const uint64_t *cells = GS_ROW(states, row);
+            uint64_t *tile = search -> tiles + ((size_t) (row / SEARCH_TILE) * tilesWide);
+
+            for(c = ZERO; c < tilesWide; c++) { tile[c] += (uint64_t) __builtin_popcountll(cells[c]); }
+        }
+    }
+
+    for(tileRow = ZERO; tileRow < tilesHigh; tileRow++)
+    {
+        for(tileCol = ZERO; tileCol < tilesWide; tileCol++)
+        {
+            uint64_t around = ZERO;
+
+            if(search -> tiles[((size_t) tileRow * tilesWide) + tileCol] == ZERO) { continue; }
+            /* A window anchored here reaches into the next tile row and one tile to either side at most */
+            for(r = tileRow; r <= tileRow + ONE && r < tilesHigh; r++)
+            {
+                for(c = tileCol - ONE; c <= tileCol + ONE; c++) { if(c >= ZERO && c < tilesWide) { around += search -> tiles[((size_t) r * tilesWide) + c]; } }
+            }
+            if(around < (uint64_t) search -> population) { continue; }
+
+            lastRow = (tileRow + ONE) * SEARCH_TILE;
+            if(lastRow > states -> rows) { lastRow = states -> rows; }
+            for(row = tileRow * SEARCH_TILE; row < lastRow; row++)
+            {
+                uint64_t live = GS_ROW(states, row)[tileCol], around[9];
+
+                if(live == ZERO) { continue; }
+                aroundCells(states, row, tileCol, around);
+                for(o = ZERO; o < search -> orientations; o++)
+                {
+                    uint64_t anchors = live, found;
+                    int bit;
+
+                    for(bit = ZERO; bit < 9; bit++)
+                    {
+                        if((search -> blockCare[o] >> bit) & ONE) { anchors &= ((search -> block[o] >> bit) & ONE) ? around[bit] : ~around[bit]; }
+                    }
+                    if(anchors == ZERO) { continue; }
+                    found = matchWord(search, o, states, row, tileCol, anchors);
+
+                    for(; found; found &= found - ONE)
+                    {
+                        int col = (tileCol * WORD_BITS) + __builtin_ctzll(found) - search -> anchorCol[o] + search -> margin;
+
+                        if(addHit(search, row - search -> anchorRow[o] + search -> margin, col, search -> transform[o]) == ZERO) { return -ONE; }
+                    }
+                }
+            }
+        }
+    }
+
+return search -> hitCount;
+}
+
+void freeSearch(Search *search)
+{
+    int o;
+
+    for(o = ZERO; o < search -> orientations; o++) { free(search -> checks[o]); search -> checks[o] = NULL; }
+    free(search -> tiles);
+    free(search -> hits);
+    search -> tiles = NULL;
+    search -> hits = NULL;
+    search -> tileCapacity = ZERO;
+    search -> hitCount = search -> hitCapacity = ZERO;
+
+return;
+}
@@ -0,0 +1,66 @@
+#ifndef GOL_SEARCH_H
+#define GOL_SEARCH_H
+
+#include <stdint.h>
+
+#include "GoL_board.h"
+#include "GoL_pyramid.h"
+#include "../Shared/GoL_patterns.h"
+
+/*
+ * Pattern search: every place where a pattern of the table sits on the board, in any of
+ * its 8 orientations, with `margin` dead cells all around it. Candidates are anchored on
+ * the pattern's first live cell, so only non-zero board words are looked at, and 64 of
+ * them are tested at once with word-wide AND and shifts: first the 3 x 3 cells around the
+ * anchor (shifted once per word for every orientation), then the rest of the window.
+ * Tiles of 64 x 64 cells (one word wide) are skipped when they and their neighbours hold
+ * fewer live cells than the pattern; the counts come from a Pyramid when one is given.
+ */
+
+#define SEARCH_TILE WORD_BITS /* Tile side, so tile columns are board words */
+
+struct searchHit
+{
+    int row;       /* Top left corner of the pattern (margin not included) */
+    int col;
+    int transform; /* PATTERN_IDENTITY .. PATTERN_ANTI_TRANSPOSE */
+};
+typedef struct searchHit SearchHit;
+
+struct searchCheck
+{/* One cell of a window, relative to its anchor */
+    int row;
+    int col;
+    int live;
+};
+typedef struct searchCheck SearchCheck;
+
+struct search
+{
+    const char *name;
+    int margin;
+    int population;
+    int orientations;                          /* Distinct ones, symmetric patterns have fewer than 8 */
+    int transform[PATTERN_TRANSFORMS];
+    int height[PATTERN_TRANSFORMS];            /* Window: the pattern plus its margin, at most 64 x 64 */
+    int width[PATTERN_TRANSFORMS];
+    int anchorRow[PATTERN_TRANSFORMS];         /* First live cell of the window, row major */
+    int anchorCol[PATTERN_TRANSFORMS];
+    int block[PATTERN_TRANSFORMS];             /* The 3 x 3 cells around the anchor, bit (row + 1) * 3 + (col + 1) */
+    int blockCare[PATTERN_TRANSFORMS];         /* Those of them inside the window */
+    uint64_t want[PATTERN_TRANSFORMS][WORD_BITS]; /* Window rows, bit j => column j */
+    SearchCheck *checks[PATTERN_TRANSFORMS];   /* The rest of the window, live cells first (they fail more anchors) */
+    int checkCount[PATTERN_TRANSFORMS];
+    uint64_t *tiles;                           /* Live cells per tile of the last search */
+    size_t tileCapacity;
+    SearchHit *hits;
+    long hitCount;
+    long hitCapacity;
+};
+typedef struct search Search;
+
+int newSearch(Search *search, const Pattern *pattern, int margin); /* RETURN 0 => pattern plus margin wider than 64, or no memory */
+long searchGs(Search *search, Gs *states, Pyramid *pyramid); /* pyramid may be NULL, RETURN hits (-1 => out of memory) */
+void freeSearch(Search *search);
+
+#endif /* GOL_SEARCH_H */
@@ -0,0 +1,145 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "GoL_share.h"
+
+static struct shareSlot *slotAt(Share *share, uint64_t frame)
+{
+return (struct shareSlot *) (share -> memory + 64 + ((frame % share -> header -> slots) * share -> header -> slotBytes));
+}
+
+int openShare(Share *share, const char *name, Gs *states) /* Writer, RETURN 1 => OK! */
+{
+    uint64_t slotBytes = sizeof(struct shareSlot) + (gsWords(states -> rows, states -> cols) * sizeof(uint64_t));
+    int fd;
+
+    memset(share, ZERO, sizeof(Share));
+    if(strlen(name) >= sizeof(share -> name)) { return ZERO; }
+    strcpy(share -> name, name);
+    share -> writer = ONE;
+    slotBytes = (slotBytes + 63) & ~(uint64_t) 63;
+    share -> size = 64 + (SHARE_SLOTS * slotBytes);
+
+    /* A fresh object every time: viewers of an older run keep their mapping, and never see it shrink */
+    shm_unlink(name);
+    if((fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600)) < ZERO) { return ZERO; }
+    if(ftruncate(fd, (off_t) share -> size) != ZERO
+       || (share -> memory = mmap(NULL, share -> size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, ZERO)) == MAP_FAILED)
+    {
+        close(fd);
+        shm_unlink(name);
+
+    return ZERO;
+    }
+    close(fd);
+
+    share -> header = (struct shareHeader *) share -> memory;
+    share -> header -> slots = SHARE_SLOTS;
+    share -> header -> rows = (uint32_t) states -> rows;
+    share -> header -> cols = (uint32_t) states -> cols;
+    share -> header -> words = (uint32_t) states -> words;
+    share -> header -> alive = ONE;
+    share -> header -> slotBytes = slotBytes;
+    share -> header -> published = ZERO;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(share -> header -> magic, SHARE_MAGIC, FOUR);
+
+return ONE;
+}
+
+void publishGs(Share *share, Gs *states, long generation)
+{
+    uint64_t frame = share -> header -> published;
+    struct shareSlot *slot = slotAt(share, frame);
+    uint64_t sequence = slot -> sequence;
+
+    __atomic_store_n(&slot -> sequence, sequence + ONE, __ATOMIC_RELAXED); /* Odd: keep out */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot -> generation = (uint64_t) generation;
+    slot -> population = (uint64_t) numOfL(states);
+    memcpy(slot + ONE, states -> gameState1, gsWords(states -> rows, states -> cols) * sizeof(uint64_t));
+    __atomic_store_n(&slot -> sequence, sequence + TWO, __ATOMIC_RELEASE);
+    __atomic_store_n(&share -> header -> published, frame + ONE, __ATOMIC_RELEASE);
+
+return;
+}
+
+int attachShare(Share *share, const char *name) /* Reader, RETURN 1 => OK! */
+{
+    struct stat info;
+    struct shareHeader *header;
+    int fd;
+
+    memset(share, ZERO, sizeof(Share));
+    if((fd = shm_open(name, O_RDONLY, ZERO)) < ZERO) { return ZERO; }
+    if(fstat(fd, &info) != ZERO || (size_t) info.st_size < 64
+       || (share -> memory = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_SHARED, fd, ZERO)) == MAP_FAILED)
+    {
+        close(fd);
+
+    return ZERO;
+    }
+    close(fd);
+    share -> size = (size_t) info.st_size;
+    header = share -> header = (struct shareHeader *) share -> memory;
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if(memcmp(header -> magic, SHARE_MAGIC, FOUR) != ZERO || header -> slots == ZERO
+       || header -> words != (uint32_t) WORDS_FOR(header -> cols)
+       || header -> slotBytes < sizeof(struct shareSlot) + (gsWords((int) header -> rows, (int) header -> cols) * sizeof(uint64_t))
+       || share -> size < 64 + (header -> slots * header -> slotBytes))
+    {
+        munmap(share -> memory, share -> size);
+        share -> memory = NULL;
+
+    return ZERO;
+    }
+
+return ONE;
+}
+
+int readShare(Share *share, Gs *states, long *generation) /* RETURN 1 => a newer frame was copied */
+{/* states must be rows x cols of the header */
+    uint64_t published, before, after;
+    struct shareSlot *slot;
+
+    while(ONE)
+    {
+        published = __atomic_load_n(&share -> header -> published, __ATOMIC_ACQUIRE);
+        if(published == ZERO || published == share -> lastRead) { return ZERO; }
+
+        slot = slotAt(share, published - ONE);
+        before = __atomic_load_n(&slot -> sequence, __ATOMIC_ACQUIRE);
+        if(before & ONE) { continue; /* Being written right now */ }
+        memcpy(states -> gameState1, slot + ONE, gsWords(states -> rows, states -> cols) * sizeof(uint64_t));
+        *generation = (long) slot -> generation;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&slot -> sequence, __ATOMIC_RELAXED);
+        if(before == after) { break; }
+        /* Overwritten while copying: the writer lapped the ring, take the newest again */
+    }
+    markAll(states); /* A whole new board for a pyramid of it */
+    if(share -> lastRead != ZERO) { share -> missed += published - share -> lastRead - ONE; }
+    share -> lastRead = published;
+
+return ONE;
+}
+
+void closeShare(Share *share)
+{
+    if(share -> memory == NULL) { return; }
+    if(share -> writer)
+    {
+        __atomic_store_n(&share -> header -> alive, ZERO, __ATOMIC_RELEASE);
+        shm_unlink(share -> name); /* Attached viewers keep the last frame */
+    }
+    munmap(share -> memory, share -> size);
+    share -> memory = NULL;
+
+return;
+}
@@ -0,0 +1,58 @@
+#ifndef GOL_SHARE_H
+#define GOL_SHARE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "GoL_board.h"
+
+/*
+ * Live view: the simulation publishes every generation into a ring of frames in
+ * shared memory (shm_open), viewers attach and copy the newest one without locks.
+ * Each slot is a seqlock: odd sequence => being written, a reader that sees the
+ * sequence change under it just tries again. The writer never waits for anyone.
+ */
+
+#define SHARE_NAME "/gol_view"
+#define SHARE_MAGIC "GoLS"
+#define SHARE_SLOTS 4
+
+struct shareHeader
+{
+    char magic[FOUR];    /* Written last, a half set up header is never taken for a board */
+    uint32_t slots;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t words;      /* uint64_t per packed row */
+    uint32_t alive;      /* 0 once the simulation is gone */
+    uint64_t slotBytes;  /* shareSlot + rows * words * uint64_t, multiple of 64 */
+    uint64_t published;  /* Frames so far, the newest is in slot (published - 1) % slots */
+};
+
+struct shareSlot
+{
+    uint64_t sequence;   /* Seqlock */
+    uint64_t generation;
+    uint64_t population;
+    uint64_t unused[FIVE]; /* Rows start on their own cache line */
+};
+
+struct share
+{
+    int writer;
+    char name[64];
+    size_t size;
+    unsigned char *memory;
+    struct shareHeader *header;
+    uint64_t lastRead;   /* Reader: frame number of the last copy */
+    uint64_t missed;     /* Reader: frames published but never seen */
+};
+typedef struct share Share;
+
+int openShare(Share *share, const char *name, Gs *states); /* Writer, RETURN 1 => OK! */
+void publishGs(Share *share, Gs *states, long generation);
+int attachShare(Share *share, const char *name); /* Reader, RETURN 1 => OK! */
+int readShare(Share *share, Gs *states, long *generation); /* RETURN 1 => a newer frame was copied */
+void closeShare(Share *share);
+
+#endif /* GOL_SHARE_H */
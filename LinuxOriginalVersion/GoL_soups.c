@@ -0,0 +1,194 @@
+#define _XOPEN_SOURCE   600 /* NEEDED FOR getopt() */
+#define _POSIX_C_SOURCE 200112L /* NEEDED FOR clock_gettime() */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "GoL_board.h"
+#include "GoL_batch.h"
+
+/* Runs many small random soups until they die out or settle, BATCH_LANES at a time (see GoL_batch.h) */
+
+enum soupEnd
+{
+    SOUP_EXTINCT = 0, /* No live cell left */
+    SOUP_STILL,       /* Stopped changing (a still life, or several) */
+    SOUP_BLINKING,    /* Settled into period 2 (blinkers, beacons, ... next to still lifes) */
+    SOUP_RUNNING,     /* Still changing at -g generations (longer periods, or not settled yet) */
+    SOUP_ENDS
+};
+
+static const char *endNames[SOUP_ENDS] = { "extinct", "still", "period 2", "running" };
+
+void printUsage(const char *program);
+void soupGs(Gs *states, int percent, unsigned seed, long soup);
+void reportSoup(long soup, int end, long generation, long population, int verbose, long *ends);
+
+int main(int argc, char *argv[])
+{
+    Batch batch;
+    Gs board, previous, older;
+    struct timespec started, finished;
+    long soups = 10000, maxGenerations = 1000, nextSoup = ZERO, done = ZERO, soup[BATCH_LANES], age[BATCH_LANES], populations[BATCH_LANES], ends[SOUP_ENDS] = { ZERO };
+    long long cellGenerations = ZERO;
+    int rows = ROWS, cols = COLS, percent = 35, verbose = ZERO, single = ZERO, option, lane, end;
+    unsigned seed = ONE;
+    double seconds;
+
+    while((option = getopt(argc, argv, "r:c:n:d:S:g:v1")) != -ONE)
+    {
+        if(option == 'r') { rows = atoi(optarg) + TWO; /* + dead edge */ }
+        else if(option == 'c') { cols = atoi(optarg) + TWO; }
+        else if(option == 'n') { soups = atol(optarg); }
+        else if(option == 'd') { percent = atoi(optarg); }
+        else if(option == 'S') { seed = (unsigned) atol(optarg); }
+        else if(option == 'g') { maxGenerations = atol(optarg); }
+        else if(option == 'v') { verbose = ONE; }
+        else if(option == '1') { single = ONE; }
+        else { printUsage(argv[ZERO]); return ONE; }
+    }
+    if(optind != argc || rows < THREE || cols < THREE || soups < ZERO || percent < ZERO || percent > 100 || maxGenerations < ONE)
+    {
+        printUsage(argv[ZERO]);
+
+    return ONE;
+    }
+
+    if(newGs(&board, rows, cols) == ZERO || newGs(&previous, rows, cols) == ZERO || newGs(&older, rows, cols) == ZERO || newBatch(&batch, rows, cols) == ZERO)
+    {
+        printf("%s", "\n*ERROR*\nNot enough memory!\n");
+
+    return ONE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &started);
+
+    if(single)
+    {/* For comparison: one board at a time with processGs_FoT() */
+        size_t bytes = (size_t) rows * (size_t) board.words * sizeof(uint64_t);
+        long gen;
+
+        for(nextSoup = ZERO; nextSoup < soups; nextSoup++)
+        {
+            soupGs(&board, percent, seed, nextSoup);
+            for(gen = ONE, end = SOUP_RUNNING; gen <= maxGenerations; gen++)
+            {
+                memcpy(older.gameState1, previous.gameState1, bytes);
+                memcpy(previous.gameState1, board.gameState1, bytes);
+                processGs_FoT(&board);
+                if(numOfL(&board) == ZERO) { end = SOUP_EXTINCT; break; }
+                if(memcmp(previous.gameState1, board.gameState1, bytes) == ZERO) { end = SOUP_STILL; break; }
+                if(gen >= TWO && memcmp(older.gameState1, board.gameState1, bytes) == ZERO) { end = SOUP_BLINKING; break; }
+            }
+            if(gen > maxGenerations) { gen = maxGenerations; }
+            cellGenerations += (long long) gen * (rows - TWO) * (cols - TWO);
+            reportSoup(nextSoup, end, gen, numOfL(&board), verbose, ends);
+        }
+        done = soups;
+    }
+
+    /* Every lane starts with a soup (or stays empty), a finished lane is reported and loaded with the next soup */
+    for(lane = ZERO; lane < BATCH_LANES && !single; lane++)
+    {
+        soup[lane] = -ONE;
+        if(nextSoup == soups) { continue; }
+        soupGs(&board, percent, seed, nextSoup);
+        loadLanes(&batch, lane, &board, ONE);
+        soup[lane] = nextSoup++;
+        age[lane] = ZERO;
+    }
+    while(done < soups)
+    {
+        int finished = ZERO;
+
+        stepBatch(&batch, ONE);
+        cellGenerations += (long long) BATCH_LANES * (rows - TWO) * (cols - TWO);
+        for(lane = ZERO; lane < BATCH_LANES; lane++)
+        {
+            if(soup[lane] < ZERO) { continue; }
+            age[lane]++;
+            finished |= !laneBit(batch.alive, lane) || !laneBit(batch.changed, lane) || (age[lane] >= TWO && !laneBit(batch.changed2, lane)) || age[lane] >= maxGenerations;
+        }
+        if(!finished) { continue; }
+
+        lanePopulations(&batch, populations);
+        for(lane = ZERO; lane < BATCH_LANES; lane++)
+        {
+            if(soup[lane] < ZERO) { continue; }
+            if(!laneBit(batch.alive, lane)) { end = SOUP_EXTINCT; }
+            else if(!laneBit(batch.changed, lane)) { end = SOUP_STILL; }
+            else if(age[lane] >= TWO && !laneBit(batch.changed2, lane)) { end = SOUP_BLINKING; }
+            else if(age[lane] >= maxGenerations) { end = SOUP_RUNNING; }
+            else { continue; }
+
+            reportSoup(soup[lane], end, age[lane], populations[lane], verbose, ends);
+            done++;
+            soup[lane] = -ONE;
+            if(nextSoup < soups)
+            {
+                soupGs(&board, percent, seed, nextSoup);
+                loadLanes(&batch, lane, &board, ONE);
+                soup[lane] = nextSoup++;
+                age[lane] = ZERO;
+            }
+            else { clearLane(&batch, lane); }
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &finished);
+    seconds = (double) (finished.tv_sec - started.tv_sec) + ((double) (finished.tv_nsec - started.tv_nsec) / 1e9);
+    printf("%ld soups of %dx%d: %ld %s, %ld %s, %ld %s, %ld %s at %ld generations\n", soups, rows - TWO, cols - TWO,
+           ends[SOUP_EXTINCT], endNames[SOUP_EXTINCT], ends[SOUP_STILL], endNames[SOUP_STILL], ends[SOUP_BLINKING], endNames[SOUP_BLINKING],
+           ends[SOUP_RUNNING], endNames[SOUP_RUNNING], maxGenerations);
+    printf("%.3f s, %.0f soups/s, %.1f M cell generations/s (%s)\n", seconds, soups / seconds, (double) cellGenerations / seconds / 1e6,
+           single ? "one board at a time" : (BATCH_LANES == 256 ? "256 lanes" : "64 lanes"));
+    freeBatch(&batch);
+    freeGs(&older);
+    freeGs(&previous);
+    freeGs(&board);
+
+return ZERO;
+}
+
+void soupGs(Gs *states, int percent, unsigned seed, long soup)
+{/* Random cells inside the dead edge (xorshift seeded by seed and soup, the same soup either way) */
+    uint64_t state = ((uint64_t) seed << 32) ^ ((uint64_t) soup * 0x9e3779b97f4a7c15ULL) ^ 0x2545f4914f6cdd1dULL;
+    int row, col;
+
+    clearGs(states);
+    for(row = ONE; row < states -> rows - ONE; row++)
+    {
+        for(col = ONE; col < states -> cols - ONE; col++)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            if((int) (state % 100) < percent) { SET_CELL(states, row, col); }
+        }
+    }
+
+return;
+}
+
+void reportSoup(long soup, int end, long generation, long population, int verbose, long *ends)
+{
+    ends[end]++;
+    if(verbose) { printf("Soup %ld: %s, Generation = %ld, Population = %ld\n", soup, endNames[end], generation, population); }
+
+return;
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [-r rows] [-c cols] [-n soups] [-d percent] [-S seed] [-g generations] [-v] [-1]\n"
+           "  -r, -c  Board size of every soup (default %dx%d)\n"
+           "  -n      Soups to run (default 10000), -d %% live cells (default 35), -S picks them\n"
+           "  -g      Give up on a soup that still changes after this many generations (default 1000)\n"
+           "  -v      One line per soup\n"
+           "  -1      One board at a time with processGs_FoT(), to compare\n",
+           program, ROWS - TWO, COLS - TWO);
+
+return;
+}
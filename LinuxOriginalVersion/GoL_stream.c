@@ -0,0 +1,116 @@
+#define _XOPEN_SOURCE   600 /* NEEDED FOR getopt() */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "GoL_board.h"
+#include "GoL_mapped.h"
+#include "../Shared/GoL_patterns.h"
+
+/* Steps a board file in place, out of core (see GoL_mapped.h): no menus, no drawing */
+
+void printUsage(const char *program);
+void soupMapped(MappedGs *board, int percent, unsigned seed);
+
+int main(int argc, char *argv[])
+{
+    MappedGs board;
+    const Pattern *pattern = NULL;
+    long gen, generations = ONE, every = ZERO;
+    long long population = ZERO;
+    int rows = ZERO, cols = ZERO, percent = ZERO, x = ONE, y = ONE, option;
+    unsigned seed = ONE;
+
+    while((option = getopt(argc, argv, "r:c:d:S:P:x:y:g:v:")) != -ONE)
+    {
+        if(option == 'r') { rows = atoi(optarg) + TWO; /* + dead edge */ }
+        else if(option == 'c') { cols = atoi(optarg) + TWO; }
+        else if(option == 'd') { percent = atoi(optarg); }
+        else if(option == 'S') { seed = (unsigned) atol(optarg); }
+        else if(option == 'P')
+        {
+            if((pattern = findPattern(optarg)) == NULL) { printUsage(argv[ZERO]); return ONE; }
+        }
+        else if(option == 'x') { x = atoi(optarg); }
+        else if(option == 'y') { y = atoi(optarg); }
+        else if(option == 'g') { generations = atol(optarg); }
+        else if(option == 'v') { every = atol(optarg); }
+        else { printUsage(argv[ZERO]); return ONE; }
+    }
+    if(optind != argc - ONE || generations < ZERO || every < ZERO || percent < ZERO || percent > 100 || ((rows || cols) && (rows < THREE || cols < THREE)))
+    {
+        printUsage(argv[ZERO]);
+
+    return ONE;
+    }
+
+    if(rows && createMapped(argv[optind], rows, cols) == ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nCannot create ", argv[optind], "!\n");
+
+    return ONE;
+    }
+    if(openMapped(&board, argv[optind]) == ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nCannot map ", argv[optind], " (a packed gamestate with word rows, see GoL_file.h)!\n");
+
+    return ONE;
+    }
+    if(percent) { soupMapped(&board, percent, seed); }
+    if(pattern != NULL)
+    {/* Straight into the mapping: same packed rows as a Gs */
+        stampPattern(mappedRow(&board, ZERO), board.rows, board.cols, board.words, pattern, x, y);
+    }
+
+    for(gen = ONE; gen <= generations; gen++)
+    {
+        population = stepMapped(&board);
+        if(every && (gen % every == ZERO || gen == generations)) { printf("Generation = %ld, Population = %lld\n", gen, population); fflush(stdout); }
+    }
+
+    if(closeMapped(&board) == ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nCannot write ", argv[optind], " back!\n");
+
+    return ONE;
+    }
+
+return ZERO;
+}
+
+void soupMapped(MappedGs *board, int percent, unsigned seed)
+{/* Random cells inside the dead edge, one row at a time (xorshift, so a seed gives the same soup anywhere) */
+    uint64_t state = ((uint64_t) seed << 32) ^ 0x9e3779b97f4a7c15ULL;
+    int row, col;
+
+    for(row = ONE; row < board -> rows - ONE; row++)
+    {
+        uint64_t *cells = mappedRow(board, row);
+
+        for(col = ONE; col < board -> cols - ONE; col++)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            if((int) (state % 100) < percent) { cells[col / WORD_BITS] |= 1ULL << (col % WORD_BITS); }
+        }
+    }
+
+return;
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [-r rows -c cols] [-d percent] [-S seed] [-P pattern -x col -y row] [-g generations] [-v every] board.bin\n"
+           "  -r, -c  Create a new, empty board file of this size first\n"
+           "  -d      Fill it with a random soup of this %% of live cells (-S picks the soup)\n"
+           "  -P      Stamp a pattern from the menu by name, top left corner at -x, -y\n"
+           "  -g      Generations to step (default 1), the file is left at the last one\n"
+           "  -v      Print the population every N generations\n",
+           program);
+
+return;
+}
@@ -0,0 +1,123 @@
+#define _XOPEN_SOURCE   600 /* NEEDED FOR getopt() & poll() */
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+
+#include "GoL_board.h"
+#include "GoL_render.h"
+#include "GoL_input.h"
+#include "GoL_share.h"
+
+/* Watches a running GameOfLife_Linux -p name, any number of viewers can attach and leave */
+
+#define STATUS_LINES 4 /* Generation, Population, Skipped & Controls */
+#define FRAME_RATE 30 /* Frames drawn per second at most, the simulation may be far quicker */
+#define PAN_STEP 8 /* Dots */
+
+void printUsage(const char *program);
+
+int main(int argc, char *argv[])
+{
+    Share share;
+    Pyramid pyramid;
+    Gs states;
+    View view;
+    struct pollfd waitFor;
+    const char *name = SHARE_NAME;
+    long generation = ZERO;
+    int keys[MAX_KEYS], count, i, option, mode = RENDER_CELLS, zoom = ONE, threshold = ZERO, running = ONE, redraw;
+    char status[256];
+
+    while((option = getopt(argc, argv, "p:m:z:t:")) != -ONE)
+    {
+        if(option == 'p') { name = optarg; }
+        else if(option == 'm') { mode = renderModeFromName(optarg); }
+        else if(option == 'z') { zoom = atoi(optarg); }
+        else if(option == 't') { threshold = atoi(optarg); }
+        else { printUsage(argv[ZERO]); return ONE; }
+    }
+    if(mode < ZERO || zoom < ONE || threshold < ZERO || threshold > 100)
+    {
+        printUsage(argv[ZERO]);
+
+    return ONE;
+    }
+
+    if(attachShare(&share, name) == ZERO)
+    {
+        printf("%s%s%s", "\n*ERROR*\nNo simulation is shared as ", name, " (GameOfLife_Linux -p)!\n");
+
+    return ONE;
+    }
+    if(newGs(&states, (int) share.header -> rows, (int) share.header -> cols) == ZERO)
+    {
+        printf("%s", "\n*ERROR*\nNot enough memory for the board!\n");
+        closeShare(&share);
+
+    return ONE;
+    }
+    initView(&view, mode, STATUS_LINES);
+    while(view.zoom < zoom) { zoomView(&view, ZERO); }
+    view.threshold = threshold;
+    if(newPyramid(&pyramid, &states)) { view.pyramid = &pyramid; }
+    rawTerminal(ONE);
+
+    while(running)
+    {/* Nothing here can hold up the simulation: a frame is copied out, or skipped */
+        redraw = readShare(&share, &states, &generation);
+
+        waitFor.fd = STDIN_FILENO;
+        waitFor.events = POLLIN;
+        if(poll(&waitFor, ONE, 1000 / FRAME_RATE) > ZERO)
+        {
+            if((count = readKeys(keys)) < ZERO) { break; }
+            for(i = ZERO; i < count; i++)
+            {
+                int key = keys[i];
+
+                if(key == 'q' || key == 'Q' || key == KEY_ESC || key == THREE /* Ctrl-C */) { running = ZERO; }
+                else if(key == KEY_UP || key == 'w' || key == 'W') { panView(&view, &states, ZERO, -PAN_STEP * view.zoom); }
+                else if(key == KEY_DOWN || key == 's' || key == 'S') { panView(&view, &states, ZERO, PAN_STEP * view.zoom); }
+                else if(key == KEY_LEFT || key == 'a' || key == 'A') { panView(&view, &states, -PAN_STEP * view.zoom, ZERO); }
+                else if(key == KEY_RIGHT || key == 'd' || key == 'D') { panView(&view, &states, PAN_STEP * view.zoom, ZERO); }
+                else if(key == 'z' || key == 'Z') { zoomView(&view, ONE); }
+                else if(key == 'x' || key == 'X') { zoomView(&view, ZERO); }
+            }
+            redraw = ONE;
+        }
+
+        if(redraw)
+        {
+            sprintf(status, "%s%ld%s%ld%s%s%lu%s%s", "Generation = ", generation, "\033[K\nPopulation = ", numOfL(&states),
+                    (__atomic_load_n(&share.header -> alive, __ATOMIC_ACQUIRE) ? "" : "   *SIMULATION ENDED*"),
+                    "\033[K\nViewer skipped ", (unsigned long) share.missed, " generations\033[K\n",
+                    "[arrows] pan  [z/x] zoom  [q] quit\033[K\n");
+            printGs(&states, &view, status);
+        }
+    }
+
+    rawTerminal(ZERO);
+    printf("%s", "\n");
+    if(view.pyramid != NULL) { freePyramid(view.pyramid); }
+    freeView(&view);
+    freeGs(&states);
+    closeShare(&share);
+
+return ZERO;
+}
+
+void printUsage(const char *program)
+{
+    printf("Usage: %s [-p name] [-m cells|half|braille] [-z zoom] [-t percent]\n"
+           "  -p      Shared board to watch (default %s)\n"
+           "  -m      cells: [] per cell | half: 1x2 cells per character | braille: 2x4 cells per character\n"
+           "  -z      Cells per dot side when zoomed out (rounded up to a power of 2)\n"
+           "  -t      Zoomed out dots light up at this %% of live cells (0 => any)\n",
+           program, SHARE_NAME);
+
+return;
+}
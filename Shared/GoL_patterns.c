@@ -0,0 +1,237 @@
+#include <string.h>
+
+#include "GoL_patterns.h"
+
+/*
+ * Row bits are written right to left in hex, so each row is
+ * followed by a picture of it in the usual left to right order.
+ */
+const Pattern patternTable[] =
+{
+    { "Blinker", "period 2", 1, 3,
+      { 0x7 /* XXX */ } },
+
+    { "Toad", "period 2", 2, 4,
+      { 0xe,   /* .XXX */
+        0x7 }  /* XXX. */ },
+
+    { "Beacon", "period 2", 4, 4,
+      { 0x3,   /* XX.. */
+        0x3,   /* XX.. */
+        0xc,   /* ..XX */
+        0xc }  /* ..XX */ },
+
+    { "Glider", "", 3, 3,
+      { 0x2,   /* .X. */
+        0x4,   /* ..X */
+        0x7 }  /* XXX */ },
+
+    { "Pulsar", "period 3", 13, 13,
+      { 0x71c,    /* ..XXX...XXX.. */
+        0x0,      /* ............. */
+        0x10a1,   /* X....X.X....X */
+        0x10a1,   /* X....X.X....X */
+        0x10a1,   /* X....X.X....X */
+        0x71c,    /* ..XXX...XXX.. */
+        0x0,      /* ............. */
+        0x71c,    /* ..XXX...XXX.. */
+        0x10a1,   /* X....X.X....X */
+        0x10a1,   /* X....X.X....X */
+        0x10a1,   /* X....X.X....X */
+        0x0,      /* ............. */
+        0x71c }   /* ..XXX...XXX.. */ },
+
+    { "R-pentomino", "", 3, 3,
+      { 0x6,   /* .XX */
+        0x3,   /* XX. */
+        0x2 }  /* .X. */ },
+
+    { "Penta-decathlon", "period 15", 8, 3,
+      { 0x7,   /* XXX */
+        0x5,   /* X.X */
+        0x7,   /* XXX */
+        0x7,   /* XXX */
+        0x7,   /* XXX */
+        0x7,   /* XXX */
+        0x5,   /* X.X */
+        0x7 }  /* XXX */ },
+
+    { "LWSS", "spaceship", 4, 5,
+      { 0x1e,   /* .XXXX */
+        0x11,   /* X...X */
+        0x10,   /* ....X */
+        0x9 }   /* X..X. */ },
+
+    { "Boat", "still life", 3, 3,
+      { 0x3,   /* XX. */
+        0x5,   /* X.X */
+        0x2 }  /* .X. */ },
+
+    { "Game of Life", "title", 15, 50,
+      { 0x3fbf87f41083eULL,   /* .XXXXX.....X....X.....X.XXXXXXX....XXXXXXX.XXXXXXX */
+        0x00a0801631441ULL,   /* X.....X...X.X...XX...XX.X..........X.....X.X...... */
+        0x00a0801552201ULL,   /* X........X...X..X.X.X.X.X..........X.....X.X...... */
+        0x0fa081f494179ULL,   /* X..XXXX.X.....X.X..X..X.XXXXX......X.....X.XXXXX.. */
+        0x00a0801417f41ULL,   /* X.....X.XXXXXXX.X.....X.X..........X.....X.X...... */
+        0x00a0801414141ULL,   /* X.....X.X.....X.X.....X.X..........X.....X.X...... */
+        0x00bf87f41413eULL,   /* .XXXXX..X.....X.X.....X.XXXXXXX....XXXXXXX.X...... */
+        0x0000000000000ULL,   /* .................................................. */
+        0x0000007f7f701ULL,   /* X.......XXX.XXXXXXX.XXXXXXX....................... */
+        0x0000000101201ULL,   /* X........X..X.......X............................. */
+        0x0000000101201ULL,   /* X........X..X.......X............................. */
+        0x0000001f1f201ULL,   /* X........X..XXXXX...XXXXX......................... */
+        0x0000000101201ULL,   /* X........X..X.......X............................. */
+        0x0000000101201ULL,   /* X........X..X.......X............................. */
+        0x0000007f0177fULL }  /* XXXXXXX.XXX.X.......XXXXXXX....................... */ },
+
+    { "Penta-decathlon 10x9", "period 15, 3 generations on", 10, 9,
+      { 0x38,    /* ...XXX... */
+        0x44,    /* ..X...X.. */
+        0x82,    /* .X.....X. */
+        0x0,     /* ......... */
+        0x101,   /* X.......X */
+        0x101,   /* X.......X */
+        0x0,     /* ......... */
+        0x82,    /* .X.....X. */
+        0x44,    /* ..X...X.. */
+        0x38 }   /* ...XXX... */ }
+};
+
+const int patternCount = sizeof(patternTable) / sizeof(patternTable[0]);
+
+const Pattern *findPattern(const char *name)
+{
+    int i;
+
+    for(i = 0; i < patternCount; i++) { if(strcmp(patternTable[i].name, name) == 0) { return &patternTable[i]; } }
+
+return NULL;
+}
+
+int patternCell(const Pattern *pattern, int row, int col)
+{
+    if(row < 0 || row >= pattern -> rows || col < 0 || col >= pattern -> cols) { return 0; }
+
+return (int) ((pattern -> bits[row] >> col) & 1);
+}
+
+int patternPopulation(const Pattern *pattern)
+{
+    int row, population = 0;
+
+    for(row = 0; row < pattern -> rows; row++) { population += __builtin_popcountll(pattern -> bits[row]); }
+
+return population;
+}
+
+static uint64_t reverseRow(uint64_t bits, int cols)
+{
+    bits = ((bits >> 1) & 0x5555555555555555ULL) | ((bits & 0x5555555555555555ULL) << 1);
+    bits = ((bits >> 2) & 0x3333333333333333ULL) | ((bits & 0x3333333333333333ULL) << 2);
+    bits = ((bits >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((bits & 0x0f0f0f0f0f0f0f0fULL) << 4);
+    bits = __builtin_bswap64(bits);
+
+return bits >> (64 - cols);
+}
+
+static void flipRows(Pattern *pattern)
+{
+    int top, bottom;
+
+    for(top = 0, bottom = pattern -> rows - 1; top < bottom; top++, bottom--)
+    {
+        uint64_t swap = pattern -> bits[top];
+
+        pattern -> bits[top] = pattern -> bits[bottom];
+        pattern -> bits[bottom] = swap;
+    }
+
+return;
+}
+
+static void flipCols(Pattern *pattern)
+{
+    int row;
+
+    for(row = 0; row < pattern -> rows; row++) { pattern -> bits[row] = reverseRow(pattern -> bits[row], pattern -> cols); }
+
+return;
+}
+
+void transformPattern(const Pattern *src, int transform, Pattern *dst)
+{
+    int transposed = (transform == PATTERN_ROT90 || transform == PATTERN_ROT270
+                   || transform == PATTERN_TRANSPOSE || transform == PATTERN_ANTI_TRANSPOSE);
+
+    dst -> name = src -> name;
+    dst -> info = src -> info;
+    memset(dst -> bits, 0, sizeof(dst -> bits));
+
+    if(transposed)
+    {
+        int row, col;
+
+        dst -> rows = src -> cols;
+        dst -> cols = src -> rows;
+        for(row = 0; row < src -> rows; row++)
+        {
+            for(col = 0; col < src -> cols; col++) { dst -> bits[col] |= ((src -> bits[row] >> col) & 1) << row; }
+        }
+    }
+    else
+    {
+        dst -> rows = src -> rows;
+        dst -> cols = src -> cols;
+        memcpy(dst -> bits, src -> bits, sizeof(src -> bits[0]) * src -> rows);
+    }
+
+    /* Every orientation is (maybe) a transpose followed by row and/or column flips */
+    switch(transform)
+    {
+        case PATTERN_ROT90: case PATTERN_FLIP_X: flipCols(dst); break;
+        case PATTERN_ROT270: case PATTERN_FLIP_Y: flipRows(dst); break;
+        case PATTERN_ROT180: case PATTERN_ANTI_TRANSPOSE: flipRows(dst); flipCols(dst); break;
+        default: break;
+    }
+
+return;
+}
+
+void stampPattern(uint64_t *board, int boardRows, int boardCols, int words,
+                  const Pattern *pattern, int x, int y)
+{
+    int i;
+    uint64_t lastMask = (boardCols & 63) ? ((1ULL << (boardCols & 63)) - 1) : ~0ULL;
+
+    if(x >= boardCols || x <= -(pattern -> cols) || y >= boardRows || y <= -(pattern -> rows)) { return; }
+
+    for(i = 0; i < pattern -> rows; i++)
+    {
+        int row = y + i, word, shift;
+        uint64_t bits = pattern -> bits[i];
+        uint64_t *dst;
+
+        if(row < 0 || row >= boardRows || bits == 0) { continue; }
+        dst = board + ((size_t) row * words);
+
+        if(x < 0) { bits >>= -x; word = 0; shift = 0; }
+        else { word = x >> 6; shift = x & 63; }
+
+        dst[word] |= bits << shift;
+        if(shift && (word + 1) < words) { dst[word + 1] |= bits >> (64 - shift); }
+        /* Clip whatever went past the last column */
+        dst[words - 1] &= lastMask;
+    }
+
+return;
+}
+
+void stampPatternMany(uint64_t *board, int boardRows, int boardCols, int words,
+                      const Pattern *pattern, const int *xy, int count)
+{
+    int i;
+
+    for(i = 0; i < count; i++) { stampPattern(board, boardRows, boardCols, words, pattern, xy[2 * i], xy[(2 * i) + 1]); }
+
+return;
+}
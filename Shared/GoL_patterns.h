@@ -0,0 +1,65 @@
+#ifndef GOL_PATTERNS_H
+#define GOL_PATTERNS_H
+
+#include <stdint.h>
+
+/*
+ * Compiled-in pattern library shared by the Linux and Windows versions.
+ * Every pattern is stored as packed bit rows: one 64-bit word per row,
+ * bit c of a word is column c of the pattern (bit 0 => leftmost cell).
+ */
+
+#define PATTERN_MAX_SIDE 64
+
+struct golPattern
+{
+    const char *name;
+    const char *info; /* Short note for menus, "" if none */
+    int rows;
+    int cols;
+    uint64_t bits[PATTERN_MAX_SIDE];
+};
+typedef struct golPattern Pattern;
+
+/* Orientations for transformPattern() (all 8 symmetries of the square) */
+enum patternTransform
+{
+    PATTERN_IDENTITY = 0,
+    PATTERN_ROT90,       /* Clockwise */
+    PATTERN_ROT180,
+    PATTERN_ROT270,
+    PATTERN_FLIP_X,      /* Mirror left <-> right */
+    PATTERN_FLIP_Y,      /* Mirror top <-> bottom */
+    PATTERN_TRANSPOSE,   /* Mirror on the main diagonal */
+    PATTERN_ANTI_TRANSPOSE,
+    PATTERN_TRANSFORMS
+};
+
+extern const Pattern patternTable[];
+extern const int patternCount;
+
+/* NULL if no pattern has that name */
+const Pattern *findPattern(const char *name);
+
+/* 1 if the pattern has a live cell at (row, col), 0 otherwise (also when outside) */
+int patternCell(const Pattern *pattern, int row, int col);
+
+/* Live cells of the pattern */
+int patternPopulation(const Pattern *pattern);
+
+/* dst = src under one of the 8 orientations (dst may not alias src) */
+void transformPattern(const Pattern *src, int transform, Pattern *dst);
+
+/*
+ * OR the pattern into a packed board with its top left corner at column x, row y.
+ * The board is boardRows rows of `words` 64-bit words, same bit order as the patterns.
+ * Anything falling outside boardRows x boardCols is clipped, negative x/y included.
+ */
+void stampPattern(uint64_t *board, int boardRows, int boardCols, int words,
+                  const Pattern *pattern, int x, int y);
+
+/* stampPattern() for `count` copies, positions given as xy[2 * i] = x, xy[2 * i + 1] = y */
+void stampPatternMany(uint64_t *board, int boardRows, int boardCols, int words,
+                      const Pattern *pattern, const int *xy, int count);
+
+#endif /* GOL_PATTERNS_H */
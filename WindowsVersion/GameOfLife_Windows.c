@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "../Shared/GoL_patterns.h"
+
 /**************** Windows-platform | Start ****************/
 
 #ifdef _WIN32  /* Only compile if Windows */
@@ -162,11 +164,31 @@ void menu_print(int selected, char animated_char, const char* options_local[], i
     return;
 }
 
+#define MENU_BLINK_MS 250 /* The selection marker flips this often */
+
+void drop_other_input(HANDLE console)
+{
+    /* kbhit() and getch() leave key-ups, mouse and focus events in the console input,
+     * and the console handle stays signalled while any record is there: drop them */
+    INPUT_RECORD record;
+    DWORD count;
+
+    while (PeekConsoleInput(console, &record, 1, &count) && count == 1)
+    {
+        if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown && input_available())
+            break; /* A key for getch() (shift & co. alone are dropped too) */
+        ReadConsoleInput(console, &record, 1, &count);
+    }
+
+    return;
+}
+
 int menu_loop(const char* options_local[], int num_local)
 {
     char animated_char = '-';
     int selected = 1;
     char input;
+    HANDLE console = GetStdHandle(STD_INPUT_HANDLE);
 
     menu_print(selected, animated_char, options_local, num_local);
     for (;;)
@@ -190,7 +212,9 @@ int menu_loop(const char* options_local[], int num_local)
             else if (selected > num_local) selected = num_local;
         }
 
-        usleep(50000);
+        /* Sleep until a key arrives or the marker is due to flip */
+        drop_other_input(console);
+        WaitForSingleObject(console, MENU_BLINK_MS);
     }
     printf("%s", "\r");
 
@@ -215,11 +239,11 @@ void gamestate_initialize(char gamestate_local[ROWS][COLS])
 /**************** Patterns | Start ****************/
 
 void place_pattern(int* x, int* y, char gamestate_local[ROWS][COLS],
-                   int pattern_rows, int pattern_cols, int pattern[])
+                   const Pattern* pattern)
 {
     {   /* Check if the pattern is out of bounds */
-        bool check_x = ((*x) + pattern_rows) > ROWS;
-        bool check_y = ((*y) + pattern_cols) > COLS;
+        bool check_x = ((*x) + pattern->rows) > ROWS;
+        bool check_y = ((*y) + pattern->cols) > COLS;
 
         printf("\n\r");
         if (check_x || check_y)
@@ -234,14 +258,17 @@ void place_pattern(int* x, int* y, char gamestate_local[ROWS][COLS],
 
     {
         int i, j;
-        for (i = 0; i < pattern_rows; i++)
-            for (j = 0; j < pattern_cols; j++)
+        for (i = 0; i < pattern->rows; i++)
+        {
+            /* Whole row dead or outside the board => nothing to place */
+            if (pattern->bits[i] == 0 || ((*x) + i) < 0 || ((*x) + i) >= ROWS)
+                continue;
+            for (j = 0; j < pattern->cols; j++)
                 /* Ensure within bounds! */
-                if ((((*x) + i) >= 0 && ((*x) + i) < ROWS
-                 && ((*y) + j) >= 0 && ((*y) + j) < COLS)
-                 && pattern[i * pattern_cols + j] == 1)
-                    /* Compute 2D index manually! */
-                    gamestate_local[(*x) + i][(*y) + j] = pattern[i * pattern_cols + j];
+                if (((*y) + j) >= 0 && ((*y) + j) < COLS
+                 && patternCell(pattern, i, j))
+                    gamestate_local[(*x) + i][(*y) + j] = 1;
+        }
     }
 
     return;
@@ -249,124 +276,51 @@ void place_pattern(int* x, int* y, char gamestate_local[ROWS][COLS],
 
 void create_game_of_life(void)
 {
-    int pattern[15][50] =
-    {
-        {0,1,1,1,1,1,0,0,0,0,0,1,0,0,0,0,1,0,0,0,0,0,1,0,1,1,1,1,1,1,1,0,0,0,0,1,1,1,1,1,1,1,0,1,1,1,1,1,1,1},
-        {1,0,0,0,0,0,1,0,0,0,1,0,1,0,0,0,1,1,0,0,0,1,1,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,0},
-        {1,0,0,0,0,0,0,0,0,1,0,0,0,1,0,0,1,0,1,0,1,0,1,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,0},
-        {1,0,0,1,1,1,1,0,1,0,0,0,0,0,1,0,1,0,0,1,0,0,1,0,1,1,1,1,1,0,0,0,0,0,0,1,0,0,0,0,0,1,0,1,1,1,1,1,0,0},
-        {1,0,0,0,0,0,1,0,1,1,1,1,1,1,1,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,0},
-        {1,0,0,0,0,0,1,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,0},
-        {0,1,1,1,1,1,0,0,1,0,0,0,0,0,1,0,1,0,0,0,0,0,1,0,1,1,1,1,1,1,1,0,0,0,0,1,1,1,1,1,1,1,0,1,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-        {1,0,0,0,0,0,0,0,1,1,1,0,1,1,1,1,1,1,1,0,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-        {1,0,0,0,0,0,0,0,0,1,0,0,1,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-        {1,0,0,0,0,0,0,0,0,1,0,0,1,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-        {1,0,0,0,0,0,0,0,0,1,0,0,1,1,1,1,1,0,0,0,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-        {1,0,0,0,0,0,0,0,0,1,0,0,1,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-        {1,0,0,0,0,0,0,0,0,1,0,0,1,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-        {1,1,1,1,1,1,1,0,1,1,1,0,1,0,0,0,0,0,0,0,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
-    };
     int x = 6, y = 2;
     gamestate_initialize(gamestate);
-    place_pattern(&x, &y, gamestate, 15, 50, (int*) pattern);
+    place_pattern(&x, &y, gamestate, findPattern("Game of Life"));
 
     return;
 }
 
 void create_pulsar(int* x, int* y, char gamestate_local[ROWS][COLS])
 {
-    int pattern[13][13] =
-    {
-        {0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-        {1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-        {1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-        {1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-        {0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0},
-        {1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-        {1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-        {1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1},
-        {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0}
-    };
-    place_pattern(x, y, gamestate_local, 13, 13, (int*) pattern);
+    place_pattern(x, y, gamestate_local, findPattern("Pulsar"));
 
     return;
 }
 
 void create_penta_decathlon(int* x, int* y, char gamestate_local[ROWS][COLS])
 {
-    int pattern[10][9] =
-    {
-        {0, 0, 0, 1, 1, 1, 0, 0, 0},
-        {0, 0, 1, 0, 0, 0, 1, 0, 0},
-        {0, 1, 0, 0, 0, 0, 0, 1, 0},
-        {0, 0, 0, 0, 0, 0, 0, 0, 0},
-        {1, 0, 0, 0, 0, 0, 0, 0, 1},
-        {1, 0, 0, 0, 0, 0, 0, 0, 1},
-        {0, 0, 0, 0, 0, 0, 0, 0, 0},
-        {0, 1, 0, 0, 0, 0, 0, 1, 0},
-        {0, 0, 1, 0, 0, 0, 1, 0, 0},
-        {0, 0, 0, 1, 1, 1, 0, 0, 0}
-    };
-    place_pattern(x, y, gamestate_local, 10, 9, (int*) pattern);
+    place_pattern(x, y, gamestate_local, findPattern("Penta-decathlon 10x9")); /* The phase this demo always showed */
 
     return;
 }
 
 void create_lwss(int* x, int* y, char gamestate_local[ROWS][COLS])
 {
-    int pattern[4][5] =
-    {
-        {0, 1, 1, 1, 1},
-        {1, 0, 0, 0, 1},
-        {0, 0, 0, 0, 1},
-        {1, 0, 0, 1, 0}
-    };
-    place_pattern(x, y, gamestate_local, 4, 5, (int*) pattern);
+    place_pattern(x, y, gamestate_local, findPattern("LWSS"));
 
     return;
 }
 
 void create_beacon(int* x, int* y, char gamestate_local[ROWS][COLS])
 {
-    int pattern[4][4] =
-    {
-        {1, 1, 0, 0},
-        {1, 1, 0, 0},
-        {0, 0, 1, 1},
-        {0, 0, 1, 1}
-    };
-    place_pattern(x, y, gamestate_local, 4, 4, (int*) pattern);
+    place_pattern(x, y, gamestate_local, findPattern("Beacon"));
 
     return;
 }
 
 void create_boat(int* x, int* y, char gamestate_local[ROWS][COLS])
 {
-    int pattern[3][3] =
-    {
-        {1, 1, 0},
-        {1, 0, 1},
-        {0, 1, 0}
-    };
-    place_pattern(x, y, gamestate_local, 3, 3, (int*) pattern);
+    place_pattern(x, y, gamestate_local, findPattern("Boat"));
 
     return;
 }
 
 void create_R_pentomino(int* x, int* y, char gamestate_local[ROWS][COLS])
 {
-    int pattern[3][3] =
-    {
-        {0, 1, 1},
-        {1, 1, 0},
-        {0, 1, 0}
-    };
-    place_pattern(x, y, gamestate_local, 3, 3, (int*) pattern);
+    place_pattern(x, y, gamestate_local, findPattern("R-pentomino"));
 
     return;
 }
@@ -606,10 +560,14 @@ void gameplay_select(void)
     return;
 }
 
+#define GENERATION_MS 175
+
 bool gameplay_loop(void)
 {
     long int generation = 0;
     int input;
+    /* Absolute schedule: drawing time is not added on top of the wait */
+    DWORD deadline = GetTickCount();
 
     /* MAIN LOOP FOR THE GAMEPLAY! */
     for (;;)
@@ -631,17 +589,23 @@ bool gameplay_loop(void)
             else if (input == SPACE)
             {
                 printf("%s", "\nPAUSED\r");
-                for (;;)
-                    if (input_available())
-                        break;
+                /* getch() blocks until a key arrives, no polling while paused */
                 get_key_pressed();
                 clear_line();
+                deadline = GetTickCount(); /* The pause is not lateness */
             }
             else if (input == ESC)
                 break;
         }
 
-        usleep(175000);
+        deadline += GENERATION_MS;
+        {
+            DWORD now = GetTickCount();
+            if ((LONG) (deadline - now) > 0)
+                Sleep(deadline - now);
+            else
+                deadline = now; /* Behind, restart the schedule */
+        }
     }
 
     return false;
@@ -671,8 +635,7 @@ void print_manual(void)
 
     printf("\n\n\n\t\t[][]  [][]\n\t\t[][]  [][]");
 
-    /* Wait for a key press to return! */
-    while (!input_available()) { /* DO NOTHING */ }
+    /* Wait for a key press to return! (getch() blocks) */
     get_key_pressed();
 
     system(CLEAR_SCREEN);